@@ -33,6 +33,7 @@
 
 namespace fl {
     class Engine;
+    class Importer;
 
     class FL_API Console {
     public:
@@ -55,6 +56,11 @@ namespace fl {
         static const std::string KW_DATA_MAXIMUM;
         static const std::string KW_DATA_EXPORT_HEADER;
         static const std::string KW_DATA_EXPORT_INPUTS;
+        static const std::string KW_DATA_THREADS;
+        static const std::string KW_DATA_PRECISION;
+        static const std::string KW_BENCHMARK;
+        static const std::string KW_BENCHMARK_WARMUP;
+        static const std::string KW_BENCHMARK_FORMAT;
 
         static Engine* mamdani();
         static Engine* takagiSugeno();
@@ -66,6 +72,7 @@ namespace fl {
         static void process(const std::string& input, std::ostream& writer,
                 const std::string& inputFormat, const std::string& outputFormat,
                 const std::map<std::string, std::string>& options);
+        static Importer* createImporter(const std::string& format);
 
         static int readCharacter();
         static void interactive(std::ostream& writer, Engine* engine);
@@ -75,6 +82,13 @@ namespace fl {
         static void exportAllExamples(const std::string& from, const std::string& to, const std::string& path);
 #ifdef FL_CPP11
         static void benchmarkExamples(const std::string& path, int runs);
+        /**
+         * Writes the throughput, the percentiles of the latency, and the time
+         * spent in each phase of evaluating the engine on the rows of input
+         * values, either as text or as tab-separated values
+         */
+        static void benchmark(const std::string& input, const std::string& inputFormat,
+                std::ostream& writer, const std::map<std::string, std::string>& options);
 #endif
 
     public:
@@ -0,0 +1,163 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#ifndef FL_CONTEXT_H
+#define FL_CONTEXT_H
+
+#include "fl/fuzzylite.h"
+
+#include "fl/term/Discrete.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace fl {
+    class Engine;
+    class InputVariable;
+    class OutputVariable;
+    class Accumulated;
+
+    /**
+     * Holds the state of an evaluation of an engine (input values, fuzzy
+     * outputs, output values), such that Engine::process(Context&) const can
+     * evaluate the same engine from different threads using one context each.
+     * The context must be loaded again after the structure of the engine changes,
+     * and Engine::restart() compiles the functions and rules again against the new structure.
+     */
+    class FL_API Context {
+    public:
+
+        //Midpoints of the intervals of equal width in which a range is sampled
+        struct FL_API Grid {
+            scalar minimum;
+            scalar maximum;
+            std::vector<scalar> x;
+        };
+
+        //Activation degrees grouped by the terms of an output variable for weighted defuzzifiers
+        struct FL_API Weights {
+            std::vector<scalar> degrees;
+            //Position in the fuzzy output of the first term activated for each term, or -1 if none
+            std::vector<int> first;
+            //Term::isTakagiSugeno() and Term::isMonotonic() of each term when loaded
+            std::vector<bool> takagiSugeno;
+            std::vector<bool> monotonic;
+            //Values of the terms evaluated beforehand for the current row of a batch, or fl::nan
+            std::vector<scalar> values;
+        };
+
+    private:
+        void copyFrom(const Context& source);
+        void swap(Context& other);
+    protected:
+        const Engine* _engine;
+        std::vector<scalar> _inputValues;
+        std::vector<scalar> _memberships;
+        std::vector<scalar> _outputValues;
+        std::vector<scalar> _previousOutputValues;
+        std::vector<Accumulated*> _fuzzyOutputs;
+        std::vector<std::vector<scalar> > _samples;
+        std::vector<Weights> _weights;
+        std::list<Grid> _grids;
+        std::vector<scalar> _buffer;
+        Discrete _discrete;
+        bool _sharesFuzzyOutputs;
+        unsigned long _revision;
+
+    public:
+        explicit Context(const Engine* engine = fl::null);
+        Context(const Context& other);
+        Context& operator=(const Context& other);
+        virtual ~Context();
+#ifdef FL_CPP11
+        //The fuzzy outputs owned by the context are transferred, not copied
+        Context(Context&& other);
+        Context& operator=(Context&& other);
+#endif
+
+        /**
+         * Unless the fuzzy outputs are shared, the context evaluates on copies
+         * of the fuzzy outputs of the engine. Shared fuzzy outputs are those of
+         * the output variables, as used by Engine::process()
+         */
+        virtual void load(const Engine* engine, bool shareFuzzyOutputs = false);
+        virtual void unload();
+        //Whether the context is loaded for the engine at its current revision
+        virtual bool isLoaded(const Engine* engine) const;
+        //Revision of the engine when the context was loaded (see Engine::revision())
+        virtual unsigned long getRevision() const;
+        virtual const Engine* getEngine() const;
+
+        virtual void restart();
+
+        virtual void setInputValue(int index, scalar value);
+        virtual void setInputValue(const std::string& name, scalar value);
+        virtual scalar getInputValue(int index) const;
+        virtual scalar getInputValue(const InputVariable* inputVariable) const;
+        virtual const std::vector<scalar>& inputValues() const;
+        virtual std::vector<scalar>& inputValues();
+
+        /**
+         * Membership degrees of the terms of the input variables (in order of
+         * variables and terms), which are computed on demand by the rules and
+         * reset to fl::nan at the beginning of each evaluation
+         */
+        virtual const std::vector<scalar>& memberships() const;
+        virtual std::vector<scalar>& memberships();
+        virtual void clearMemberships();
+
+        virtual void setOutputValue(int index, scalar value);
+        virtual scalar getOutputValue(int index) const;
+        virtual scalar getOutputValue(const std::string& name) const;
+        virtual const std::vector<scalar>& outputValues() const;
+
+        virtual void setPreviousOutputValue(int index, scalar value);
+        virtual scalar getPreviousOutputValue(int index) const;
+
+        virtual Accumulated* fuzzyOutput(int index) const;
+        virtual Accumulated* fuzzyOutput(const OutputVariable* outputVariable) const;
+        virtual int numberOfFuzzyOutputs() const;
+
+        /**
+         * Weights sized for the terms of the output variable when loaded, or
+         * fl::null if the fuzzy output does not belong to the context
+         */
+        virtual Weights* weights(const Accumulated* fuzzyOutput);
+
+        //Buffer where the fuzzy output is accumulated if the terms of the output variable are sampled
+        virtual std::vector<scalar>& samples(int index);
+        /**
+         * Grid of the given resolution, shared by the outputs sampled over the
+         * same range, which remains valid until the context is unloaded
+         */
+        virtual const std::vector<scalar>& grid(scalar minimum, scalar maximum, int resolution);
+        //Scratch buffer reused between evaluations, such as for the membership of each accumulated term
+        virtual std::vector<scalar>& buffer();
+        //Scratch term reused between evaluations to defuzzify samples as a Discrete term
+        virtual Discrete& discrete();
+    };
+
+}
+#endif /* FL_CONTEXT_H */
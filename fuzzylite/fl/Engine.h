@@ -27,6 +27,7 @@
 
 #include "fl/fuzzylite.h"
 
+#include "fl/Context.h"
 #include "fl/defuzzifier/IntegralDefuzzifier.h"
 
 #include <string>
@@ -46,13 +47,21 @@ namespace fl {
     class FL_API Engine {
     private:
         void copyFrom(const Engine& source);
+        //Context sharing the fuzzy outputs and holding the values of the variables
+        Context& sharedContext();
+        //Compiles the terms and the loaded rules against the structure of the engine
+        void compile();
     protected:
         std::string _name;
         std::vector<InputVariable*> _inputVariables;
         std::vector<OutputVariable*> _outputVariables;
         std::vector<RuleBlock*> _ruleblocks;
+        FL_unique_ptr<Context> _context;
+        unsigned long _revision;
 
         void updateReferences() const;
+        //Activates the rule blocks on the memberships already in the context, computing the others on demand
+        void activateRuleBlocks(Context& context) const;
 
     public:
         explicit Engine(const std::string& name = "");
@@ -76,9 +85,54 @@ namespace fl {
         virtual bool isReady(std::string* status = fl::null) const;
 
         virtual void process();
+        /**
+         * Processes a block of rows stored column-major, that is, the value of
+         * the i-th input variable at the r-th row is inputs[i * rows + r], and
+         * the value of the o-th output variable is written to outputs[o * rows + r].
+         * The memberships of the input terms, and the values of the Linear and
+         * Function terms of weighted output variables that depend only on the
+         * input values, are evaluated over blocks of rows, and the rows are then
+         * activated and defuzzified one by one as in process(Context&)
+         */
+        virtual void process(const scalar* inputs, std::size_t rows, scalar* outputs);
+        /**
+         * Processes the input values of the context, which must be loaded for
+         * this engine, storing the fuzzy outputs and output values in the context
+         * and leaving the engine unchanged. Hence, different threads can process
+         * the same engine, each using its own context.
+         */
+        virtual void process(Context& context) const;
+        /**
+         * The phases of process(Context&), which can be called separately on
+         * a loaded context (e.g., to time them): activating the rule blocks on
+         * the input values, and defuzzifying the fuzzy outputs into the output
+         * values
+         */
+        virtual void activate(Context& context) const;
+        virtual void defuzzify(Context& context) const;
 
         virtual void restart();
 
+        /**
+         * Structural revision of the engine, which changes whenever its
+         * variables are added, removed or replaced, or the terms of any of
+         * its variables are added, removed or reordered. Such edits made
+         * through the vectors returned by inputVariables(), outputVariables()
+         * and Variable::terms() are not tracked, and must be followed by
+         * restart().
+         */
+        virtual unsigned long revision() const;
+        //Returns a revision greater than any returned before
+        static unsigned long nextRevision();
+
+        /**
+         * Samples the terms of the output variables with integral defuzzifiers
+         * (see OutputVariable::sampleTerms()), which must be done again after
+         * changing those terms, ranges or defuzzifiers
+         */
+        virtual void sampleOutputTerms();
+        virtual void clearSampledOutputTerms();
+
         virtual void setName(const std::string& name);
         virtual std::string getName() const;
 
@@ -112,6 +166,7 @@ namespace fl {
         virtual int numberOfInputVariables() const;
         virtual const std::vector<InputVariable*>& inputVariables() const;
         virtual void setInputVariables(const std::vector<InputVariable*>& inputVariables);
+        //Structural edits made through the vector must be followed by restart()
         virtual std::vector<InputVariable*>& inputVariables();
 
         /**
@@ -128,6 +183,7 @@ namespace fl {
         virtual int numberOfOutputVariables() const;
         virtual const std::vector<OutputVariable*>& outputVariables() const;
         virtual void setOutputVariables(const std::vector<OutputVariable*>& outputVariables);
+        //Structural edits made through the vector must be followed by restart()
         virtual std::vector<OutputVariable*>& outputVariables();
 
         /**
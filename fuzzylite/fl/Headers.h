@@ -28,6 +28,7 @@
 #include "fl/fuzzylite.h"
 
 #include "fl/Console.h"
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/Exception.h"
 
@@ -53,10 +54,12 @@
 #include "fl/factory/TermFactory.h"
 
 #include "fl/imex/CppExporter.h"
+#include "fl/imex/DataReader.h"
 #include "fl/imex/FclImporter.h"
 #include "fl/imex/FclExporter.h"
 #include "fl/imex/FisImporter.h"
 #include "fl/imex/FisExporter.h"
+#include "fl/imex/FlbExporter.h"
 #include "fl/imex/FldExporter.h"
 #include "fl/imex/FllImporter.h"
 #include "fl/imex/FllExporter.h"
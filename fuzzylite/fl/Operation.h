@@ -126,11 +126,17 @@ namespace fl {
 
         static scalar toScalar(const std::string& x, scalar alternative) FL_INOEXCEPT;
 
+        //Same as toScalar(std::string(begin, end)), but without allocating memory
+        static scalar parseScalar(const char* begin, const char* end); //throws fl::Exception
+
         static bool isNumeric(const std::string& x);
 
         template <typename T>
         static std::string str(T x, int decimals = fuzzylite::decimals());
 
+        //Appends str(x, decimals) to the text without formatting through a stream
+        static void str(scalar x, int decimals, std::string& text);
+
         template <typename T>
         static std::string join(const std::vector<T>& x, const std::string& separator);
 
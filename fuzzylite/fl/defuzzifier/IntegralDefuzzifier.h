@@ -27,14 +27,45 @@
 
 #include "fl/defuzzifier/Defuzzifier.h"
 
+#include <utility>
+#include <vector>
+
 namespace fl {
-    //TODO: check  http://en.wikipedia.org/wiki/Adaptive_quadrature
+    class Context;
 
     class FL_API IntegralDefuzzifier : public Defuzzifier {
+    public:
+
+        /**
+         * Values of the integral defuzzifiers obtained from the same samples
+         */
+        struct FL_API Sweep {
+            scalar centroid;
+            scalar bisector;
+            scalar smallestOfMaximum;
+            scalar meanOfMaximum;
+            scalar largestOfMaximum;
+
+            Sweep();
+        };
+
     protected:
         static int _defaultResolution;
 
         int _resolution;
+        bool _analytical;
+        scalar _tolerance;
+
+        virtual bool nextSupport(const Term* term, scalar from, scalar maximum,
+                scalar& start, scalar& end) const;
+        virtual bool breakpoints(const Term* term, scalar degree,
+                std::vector<scalar>& xs, scalar& low, scalar& high) const;
+        virtual bool piecewiseLinear(const Term* term, scalar minimum, scalar maximum,
+                std::vector<std::pair<scalar, scalar> >& vertices) const;
+        virtual bool adaptiveSampling(const Term* term, scalar minimum, scalar maximum,
+                std::vector<std::pair<scalar, scalar> >& vertices) const;
+        virtual void refine(const Term* term, scalar a, scalar fa,
+                scalar m, scalar fm, scalar b, scalar fb, scalar tolerance, scalar width, std::vector<std::pair<scalar, scalar> >& vertices) const;
     public:
 
         static void setDefaultResolution(int defaultResolution);
@@ -44,8 +75,36 @@ namespace fl {
         virtual ~IntegralDefuzzifier() FL_IOVERRIDE;
         FL_DEFAULT_COPY_AND_MOVE(IntegralDefuzzifier)
 
+        /**
+         * Defuzzifies the membership sampled at the midpoints of samples.size()
+         * intervals of equal width in [minimum, maximum], using the scratch
+         * buffers of the context
+         */
+        virtual scalar defuzzifySamples(const std::vector<scalar>& samples,
+                scalar minimum, scalar maximum, Context& context) const;
+
+        //Computes every integral defuzzification of the samples in a single pass
+        static Sweep sweep(const std::vector<scalar>& samples, scalar minimum, scalar maximum);
+
         virtual void setResolution(int resolution);
         virtual int getResolution() const;
+
+        /**
+         * When analytical, Triangle, Trapezoid, Rectangle and Ramp terms
+         * activated with Minimum and accumulated with Maximum are integrated
+         * exactly from their breakpoints instead of sampled.
+         */
+        virtual void setAnalytical(bool analytical);
+        virtual bool isAnalytical() const;
+
+        /**
+         * A positive tolerance makes Centroid and Bisector sample adaptively,
+         * halving intervals until the integrated membership changes by less
+         * than the tolerance (relative to the height of the curve) per unit of
+         * range, but never below the interval given by the resolution. Otherwise, the resolution is sampled uniformly.
+         */
+        virtual void setTolerance(scalar tolerance);
+        virtual scalar getTolerance() const;
     };
 }
 
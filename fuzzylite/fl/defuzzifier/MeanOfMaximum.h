@@ -38,6 +38,8 @@ namespace fl {
         virtual std::string className() const FL_IOVERRIDE;
         virtual scalar defuzzify(const Term* term,
                 scalar minimum, scalar maximum) const FL_IOVERRIDE;
+        virtual scalar defuzzifySamples(const std::vector<scalar>& samples,
+                scalar minimum, scalar maximum, Context& context) const FL_IOVERRIDE;
         virtual MeanOfMaximum* clone() const FL_IOVERRIDE;
 
         static Defuzzifier* constructor();
@@ -27,8 +27,11 @@
 
 #include "fl/defuzzifier/Defuzzifier.h"
 
+#include "fl/Context.h"
+
 namespace fl {
     class Activated;
+    class Accumulated;
 
     class FL_API WeightedDefuzzifier : public Defuzzifier {
     public:
@@ -55,6 +58,33 @@ namespace fl {
     protected:
         Type _type;
 
+        /**
+         * Accumulates the degrees of the activated terms grouped by the index
+         * of their term into the weights sized for the terms of the output
+         * variable. Returns the number of indices, or -1 if an activated term
+         * has no index or its index exceeds the size of the weights
+         */
+        virtual int accumulate(const Accumulated* fuzzyOutput, Context::Weights& weights) const;
+
+        /**
+         * Value z of the activated term for the degree w, where the type (if
+         * Automatic) and the monotonicity of its term are those resolved in
+         * the weights when loaded if the term has an index, and inferred
+         * otherwise. Tsukamoto inverts monotonic terms, and the others take
+         * the value in the weights if evaluated beforehand, or else the
+         * membership of w in the context.
+         */
+        virtual scalar value(const Activated* activated, scalar w, Type& type,
+                const Context::Weights* weights, scalar minimum, scalar maximum) const;
+
+        /**
+         * Computes the sum of the values z of the activated terms weighted by
+         * their degrees, and the sum of the degrees. If the fuzzy output has an
+         * accumulation operator, the degrees are first accumulated by term.
+         */
+        virtual void weightedSum(const Accumulated* fuzzyOutput, scalar minimum, scalar maximum,
+                scalar& sum, scalar& weights) const;
+
     };
 
 }
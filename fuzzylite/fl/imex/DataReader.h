@@ -0,0 +1,96 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#ifndef FL_DATAREADER_H
+#define FL_DATAREADER_H
+
+#include "fl/imex/FlbExporter.h"
+#include "fl/imex/FldExporter.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace fl {
+    class Engine;
+
+    /**
+     * Reads the rows of input values to evaluate an engine on, either from a
+     * grid of at most a maximum number of rows over the ranges of its input
+     * variables, or from the data in a reader, which is either binary with
+     * an flb header naming the input variables, or text in fld format.
+     */
+    class FL_API DataReader {
+    protected:
+        const Engine* _engine;
+        std::istream* _reader;
+        FldExporter _fldExporter;
+        FlbExporter _flbExporter;
+        std::vector<scalar> _row;
+
+        int _resolution;
+        std::vector<int> _sampleValues, _minSampleValues, _maxSampleValues;
+        bool _overflow;
+
+        std::string _line;
+        int _lineNumber;
+
+        bool _binary;
+        bool _singlePrecision;
+        std::size_t _columns;
+        std::vector<std::size_t> _inputColumns;
+        std::vector<scalar> _block;
+        std::size_t _blockRows, _blockRow;
+
+    public:
+        DataReader(const Engine* engine, int maximumNumberOfResults);
+        DataReader(const Engine* engine, std::istream& reader);
+        virtual ~DataReader();
+
+        //Whether the rows are lines of fld text, which can be read without parsing them
+        virtual bool readsLines() const;
+        //Number of the last line read from fld text
+        virtual int getLineNumber() const;
+
+        //Reads the next line of fld text, and returns false at the end of the data
+        virtual bool readLine(std::string& line);
+        /**
+         * Reads the next row, and returns false at the end of the data. The
+         * rows of fld text are the values of their lines as parsed, so they
+         * are empty for comments and blank lines.
+         */
+        virtual bool read(std::vector<scalar>& inputValues);
+        /**
+         * Reads the input values of up to the number of rows in column-major
+         * order, skipping empty rows, and returns the number of rows read,
+         * which is zero at the end of the data
+         */
+        virtual std::size_t read(std::vector<scalar>& inputValues, std::size_t rows);
+
+    private:
+        FL_DISABLE_COPY(DataReader)
+    };
+}
+
+#endif  /* FL_DATAREADER_H */
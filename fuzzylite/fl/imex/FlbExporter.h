@@ -0,0 +1,151 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#ifndef FL_FLBEXPORTER_H
+#define FL_FLBEXPORTER_H
+
+#include "fl/imex/Exporter.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace fl {
+    class DataReader;
+    class Engine;
+
+    /**
+     * Exports the results of an engine in a binary columnar format, which
+     * avoids the costs and loss of precision of formatting them as text.
+     *
+     * The data starts with a header made of the characters "FLB1", the number
+     * of bytes of the values (4 for float32 or 8 for float64), the name of the
+     * engine, and the names of the input and the output columns, each list
+     * preceded by its size. The header is followed by blocks of rows, each
+     * made of the number of rows followed by the values of each column in
+     * order. Sizes are unsigned 32-bit integers, strings are preceded by
+     * their length, and everything is stored in little-endian order. The
+     * header is padded with zeros to a multiple of 8 bytes, and so is the
+     * number of rows of each block (with 4 zeros), such that the float64
+     * values are aligned to 8 bytes and can be mapped in place.
+     */
+    class FL_API FlbExporter : public Exporter {
+    protected:
+        bool _exportInputValues;
+        bool _exportOutputValues;
+        bool _singlePrecision;
+        int _rowsPerBlock;
+
+        virtual void writeUnsigned(std::ostream& writer, unsigned long x) const;
+        virtual unsigned long readUnsigned(std::istream& reader) const;
+        virtual void writeString(std::ostream& writer, const std::string& x) const;
+        virtual std::string readString(std::istream& reader) const;
+        //Reads a list of strings preceded by its size, and returns the number of bytes read
+        virtual std::size_t readStrings(std::istream& reader, std::vector<std::string>& strings) const;
+        virtual void writeValues(std::ostream& writer, const scalar* values, std::size_t n) const;
+        virtual void readValues(std::istream& reader, scalar* values, std::size_t n,
+                bool singlePrecision) const;
+        virtual void writePadding(std::ostream& writer, std::size_t size) const;
+        virtual void readPadding(std::istream& reader, std::size_t size) const;
+        //Returns the number of bytes left in the reader, or negative if unknown
+        virtual std::streamoff remaining(std::istream& reader) const;
+        /**
+         * Reads the number of rows of the next block, which is zero at the
+         * end of the data, and checks the size of the block fits in the data
+         */
+        virtual std::size_t readRows(std::istream& reader, std::size_t columns,
+                bool singlePrecision) const;
+        //Writes the results of the rows of the data in blocks
+        virtual void write(Engine* engine, std::ostream& writer, DataReader& data) const;
+    public:
+        FlbExporter();
+        virtual ~FlbExporter() FL_IOVERRIDE;
+        FL_DEFAULT_COPY_AND_MOVE(FlbExporter)
+
+        virtual std::string name() const FL_IOVERRIDE;
+
+        virtual void setExportInputValues(bool exportInputValues);
+        virtual bool exportsInputValues() const;
+
+        virtual void setExportOutputValues(bool exportOutputValues);
+        virtual bool exportsOutputValues() const;
+
+        //Whether the values are exported as float32 instead of float64
+        virtual void setSinglePrecision(bool singlePrecision);
+        virtual bool isSinglePrecision() const;
+
+        virtual void setRowsPerBlock(int rowsPerBlock);
+        virtual int getRowsPerBlock() const;
+
+        virtual std::string header(const Engine* engine) const;
+
+        //WARNING: The engine will be const_casted in order to be processed!
+        virtual std::string toString(const Engine* engine) const FL_IOVERRIDE;
+        virtual std::string toString(Engine* engine, int maximumNumberOfResults) const;
+        virtual std::string toString(Engine* engine, const std::string& inputData) const;
+
+        virtual void toFile(const std::string& path, const Engine* engine) const FL_IOVERRIDE;
+        virtual void toFile(const std::string& path, Engine* engine, int maximumNumberOfResults) const;
+        virtual void toFile(const std::string& path, Engine* engine, const std::string& inputData) const;
+
+        //Whether the reader is positioned at a header, which is not consumed
+        virtual bool isHeader(std::istream& reader) const;
+        virtual void readHeader(std::istream& reader, std::string& engineName,
+                std::vector<std::string>& inputNames, std::vector<std::string>& outputNames,
+                bool& singlePrecision) const;
+        /**
+         * Reads the next block of columns in column-major order, and returns
+         * its number of rows, which is zero at the end of the data
+         */
+        virtual std::size_t readBlock(std::istream& reader, std::size_t columns,
+                bool singlePrecision, std::vector<scalar>& values) const;
+        /**
+         * Reads the next block of columns, and returns its number of rows with
+         * only the values of the given columns (e.g., from inputColumns()) in
+         * their order, which is zero at the end of the data
+         */
+        virtual std::size_t readColumns(std::istream& reader, std::size_t columns,
+                bool singlePrecision, const std::vector<std::size_t>& selected,
+                std::vector<scalar>& values) const;
+        /**
+         * Returns the index of the column named after each input variable of
+         * the engine, with the columns named as in the header
+         */
+        virtual std::vector<std::size_t> inputColumns(const Engine* engine,
+                const std::vector<std::string>& names) const;
+
+        void write(Engine* engine, std::ostream& writer, int maximumNumberOfResults) const;
+        /**
+         * Writes the results of the data in the reader, which is either binary
+         * with a header naming the input variables, or text in fld format
+         */
+        void write(Engine* engine, std::ostream& writer, std::istream& reader) const;
+        //Writes one block with the results of the rows of input values in column-major order
+        void write(Engine* engine, std::ostream& writer, std::vector<scalar>& inputValues,
+                std::size_t rows) const;
+
+        virtual FlbExporter* clone() const FL_IOVERRIDE;
+    };
+}
+
+#endif  /* FL_FLBEXPORTER_H */
@@ -30,6 +30,8 @@
 #include <vector>
 
 namespace fl {
+    class Context;
+    class DataReader;
     class Engine;
     class InputVariable;
     class OutputVariable;
@@ -40,6 +42,43 @@ namespace fl {
         bool _exportHeaders;
         bool _exportInputValues;
         bool _exportOutputValues;
+        int _threads;
+
+        //Threads created once per export, each evaluating rows on its own context
+        class Workers;
+
+        /**
+         * Rows evaluated by the workers: the first size rows, which are parsed
+         * from their lines by the worker that evaluates them if parseLines
+         */
+        struct FL_API Batch {
+            std::vector<std::vector<scalar> > rows;
+            std::vector<std::string> lines;
+            std::size_t size;
+            bool parseLines;
+            //Line of the first row in the input data for errors, or negative if none
+            int firstLine;
+
+            Batch();
+        };
+
+        //Whether the rows can be evaluated independently of each other
+        virtual bool isParallelizable(const Engine* engine) const;
+        //Evaluates and writes the rows [first, last) of the batch on the context
+        virtual void write(const Engine* engine, Context& context, std::ostream& writer,
+                Batch& batch, std::size_t first, std::size_t last) const;
+        /**
+         * Writes the rows of the batch in order after the workers evaluate
+         * contiguous partitions of them in parallel. The rows before an error
+         * are written, as when evaluating serially.
+         */
+        virtual void write(const Engine* engine, std::ostream& writer,
+                Batch& batch, Workers& workers) const;
+        //Writes the rows of the data, on the threads if parallelizable
+        virtual void write(Engine* engine, std::ostream& writer, DataReader& data) const;
+        //Writes the rows of the lines of the input data, skipping comments
+        virtual void writeData(Engine* engine, std::ostream& writer,
+                const std::string& inputData) const;
     public:
         explicit FldExporter(const std::string& separator = " ");
         virtual ~FldExporter() FL_IOVERRIDE;
@@ -59,6 +98,18 @@ namespace fl {
         virtual void setExportOutputValues(bool exportOutputValues);
         virtual bool exportsOutputValues() const;
 
+        /**
+         * Number of threads that evaluate the rows written from a number of
+         * results or from a reader (requires C++11). The output is identical
+         * for any number of threads, which is ignored (evaluating serially)
+         * if an output variable locks its previous output value or a Function
+         * term depends on the values of the output variables. Unlike serially,
+         * the threads evaluate the rows on contexts, so the input and output
+         * values of the engine are left as after Engine::restart().
+         */
+        virtual void setThreads(int threads);
+        virtual int getThreads() const;
+
         virtual std::string header(const Engine* engine) const;
 
         //WARNING: The engine will be const_casted in order to be processed!
@@ -71,10 +122,22 @@ namespace fl {
         virtual void toFile(const std::string& path, Engine* engine, const std::string& inputData) const;
 
         virtual std::vector<scalar> parse(const std::string& x) const;
+        /**
+         * Appends to the values those in the line [begin, end), parsed in place,
+         * unless the line is a comment (i.e., its first non-blank is '#')
+         */
+        virtual void parse(const char* begin, const char* end, std::vector<scalar>& values) const;
 
         void write(Engine* engine, std::ostream& writer, int maximumNumberOfResults) const;
+        /**
+         * Writes the results of the data in the reader, which is either binary
+         * with an flb header naming the input variables, or text in fld format
+         */
         void write(Engine* engine, std::ostream& writer, std::istream& reader) const;
         void write(Engine* engine, std::ostream& writer, const std::vector<scalar>& inputValues) const;
+        //Evaluates the engine on the context instead of the engine, and thus from any thread
+        void write(const Engine* engine, Context& context, std::ostream& writer,
+                const std::vector<scalar>& inputValues) const;
 
         virtual FldExporter* clone() const FL_IOVERRIDE;
     };
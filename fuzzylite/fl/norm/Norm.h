@@ -36,6 +36,15 @@ namespace fl {
     class FL_API Norm {
     public:
 
+        /**
+         * Identifies the norms whose operation callers can dispatch once per
+         * block of values, and Generic for the remaining norms
+         */
+        enum Kernel {
+            Generic, MinimumKernel, MaximumKernel, AlgebraicProductKernel,
+            AlgebraicSumKernel, BoundedDifferenceKernel, BoundedSumKernel
+        };
+
         Norm() {
         }
 
@@ -47,6 +56,17 @@ namespace fl {
         virtual std::string className() const = 0;
         virtual scalar compute(scalar a, scalar b) const = 0;
 
+        virtual Kernel kernel() const {
+            return Generic;
+        }
+
+        //c[i] = compute(a[i], b[i]) for the n values, where c may be either a or b
+        virtual void compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+            for (std::size_t i = 0; i < n; ++i) {
+                c[i] = compute(a[i], b[i]);
+            }
+        }
+
         virtual Norm* clone() const = 0;
 
     };
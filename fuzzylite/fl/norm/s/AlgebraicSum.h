@@ -34,6 +34,8 @@ namespace fl {
     public:
         std::string className() const FL_IOVERRIDE;
         scalar compute(scalar a, scalar b) const FL_IOVERRIDE;
+        Kernel kernel() const FL_IOVERRIDE;
+        void compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const FL_IOVERRIDE;
         AlgebraicSum* clone() const FL_IOVERRIDE;
 
         static SNorm* constructor();
@@ -31,6 +31,7 @@ namespace fl {
     class FL_API DrasticSum : public SNorm {
     public:
         std::string className() const FL_IOVERRIDE;
+        using SNorm::compute;
         scalar compute(scalar a, scalar b) const FL_IOVERRIDE;
         DrasticSum* clone() const FL_IOVERRIDE;
 
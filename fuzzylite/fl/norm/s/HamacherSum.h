@@ -32,6 +32,7 @@ namespace fl {
     class FL_API HamacherSum : public SNorm {
     public:
         std::string className() const FL_IOVERRIDE;
+        using SNorm::compute;
         scalar compute(scalar a, scalar b) const FL_IOVERRIDE;
         HamacherSum* clone() const FL_IOVERRIDE;
 
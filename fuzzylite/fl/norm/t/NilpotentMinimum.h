@@ -32,6 +32,7 @@ namespace fl {
     class FL_API NilpotentMinimum : public TNorm {
     public:
         std::string className() const FL_IOVERRIDE;
+        using TNorm::compute;
         scalar compute(scalar a, scalar b) const FL_IOVERRIDE;
         NilpotentMinimum* clone() const FL_IOVERRIDE;
 
@@ -28,6 +28,7 @@
 #include "fl/fuzzylite.h"
 
 #include <string>
+#include <vector>
 
 namespace fl {
     class Engine;
@@ -35,11 +36,48 @@ namespace fl {
     class TNorm;
     class SNorm;
     class Expression;
+    class Context;
+    class Variable;
+    class Term;
+    class Hedge;
 
     class FL_API Antecedent {
+    public:
+
+        /**
+         * Instruction of the postfix program to which the expression is compiled
+         * when the antecedent is loaded. Terms and constants push their activation
+         * degree (after applying the hedges in [firstHedge, lastHedge)) onto a
+         * stack, and conjunctions and disjunctions pop the top two degrees and
+         * push their result. The membership of an input term is read from (or
+         * stored in) the membership slot of the context, so it is computed once
+         * per evaluation regardless of how many rules refer to it.
+         */
+        struct FL_API Instruction {
+
+            enum Opcode {
+                InputTerm, OutputTerm, Constant, Conjunction, Disjunction
+            };
+            Opcode opcode;
+            const Variable* variable;
+            int index;
+            const Term* term;
+            int slot;
+            scalar value;
+            std::size_t firstHedge, lastHedge;
+
+            explicit Instruction(Opcode opcode = Constant);
+        };
+
     protected:
         std::string _text;
         Expression* _expression;
+        std::vector<Instruction> _instructions;
+        std::vector<const Hedge*> _hedges;
+        std::size_t _stackSize;
+        unsigned long _revision;
+
+        virtual void compile(const Expression* node, const Engine* engine, std::size_t depth);
 
     public:
         Antecedent();
@@ -61,6 +99,18 @@ namespace fl {
 
         virtual scalar activationDegree(const TNorm* conjunction, const SNorm* disjunction) const;
 
+        /**
+         * Compiles the expression against the structure of the engine. If the
+         * structure changes afterwards (see Engine::revision()), the program
+         * is evaluated without the membership slots until compiled again.
+         */
+        virtual void compile(const Engine* engine);
+        virtual const std::vector<Instruction>& instructions() const;
+
+        //Evaluates the compiled program using the values of the context
+        virtual scalar activationDegree(const TNorm* conjunction, const SNorm* disjunction,
+                Context& context) const;
+
         virtual std::string toString() const;
 
         virtual std::string toPrefix(const Expression* node = fl::null) const;
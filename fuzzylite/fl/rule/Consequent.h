@@ -35,11 +35,16 @@ namespace fl {
     class Rule;
     class Proposition;
     class TNorm;
+    class Context;
 
     class FL_API Consequent {
     protected:
         std::string _text;
         std::vector<Proposition*> _conclusions;
+        //Indices of the output variable and term of each conclusion, resolved when loaded
+        std::vector<int> _outputIndices;
+        std::vector<int> _termIndices;
+        unsigned long _revision;
 
     public:
         Consequent();
@@ -54,8 +59,15 @@ namespace fl {
         virtual void unload();
         virtual void load(Rule* rule, const Engine* engine);
         virtual void load(const std::string& consequent, Rule* rule, const Engine* engine);
+        /**
+         * Resolves the indices against the structure of the engine. If the
+         * structure changes afterwards (see Engine::revision()), the output
+         * variables are searched in the context until resolved again.
+         */
+        virtual void compile(const Engine* engine);
 
         virtual void modify(scalar activationDegree, const TNorm* activation);
+        virtual void modify(scalar activationDegree, const TNorm* activation, Context& context);
 
         virtual std::string toString() const;
 
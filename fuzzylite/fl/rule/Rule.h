@@ -38,6 +38,7 @@ namespace fl {
     class Hedge;
     class TNorm;
     class SNorm;
+    class Context;
 
     class FL_API Rule {
     protected:
@@ -78,6 +79,10 @@ namespace fl {
         virtual scalar activationDegree(const TNorm* conjunction, const SNorm* disjunction) const;
         virtual void activate(scalar degree, const TNorm* activation) const;
 
+        virtual scalar activationDegree(const TNorm* conjunction, const SNorm* disjunction,
+                Context& context) const;
+        virtual void activate(scalar degree, const TNorm* activation, Context& context) const;
+
         virtual std::string toString() const;
 
         virtual bool isLoaded() const;
@@ -37,6 +37,7 @@ namespace fl {
     class Rule;
     class TNorm;
     class SNorm;
+    class Context;
 
     class FL_API RuleBlock {
     private:
@@ -57,6 +58,7 @@ namespace fl {
         FL_DEFAULT_MOVE(RuleBlock)
 
         virtual void activate();
+        virtual void activate(Context& context) const;
 
         virtual void setName(std::string name);
         virtual std::string getName() const;
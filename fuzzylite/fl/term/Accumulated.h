@@ -40,8 +40,11 @@ namespace fl {
         void copyFrom(const Accumulated& source);
     protected:
         std::vector<Activated*> _terms;
+        //Activated terms released by clear() to be reused by addTerm()
+        std::vector<Activated*> _pool;
         scalar _minimum, _maximum;
         FL_unique_ptr<SNorm> _accumulation;
+        bool _groupByTerm;
     public:
         explicit Accumulated(const std::string& name = "",
                 scalar minimum = fl::nan,
@@ -58,7 +61,13 @@ namespace fl {
 
         virtual Accumulated* clone() const FL_IOVERRIDE;
 
+        using Term::membership;
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+        //Computes the membership using the buffer to store the membership of each term
+        virtual void membership(const scalar* x, scalar* y, std::size_t n,
+                std::vector<scalar>& buffer) const;
+        virtual void support(scalar& minimum, scalar& maximum) const FL_IOVERRIDE;
         virtual scalar activationDegree(const Term* forTerm) const;
 
         virtual std::string toString() const FL_IOVERRIDE;
@@ -76,10 +85,22 @@ namespace fl {
         virtual void setAccumulation(SNorm* accumulation);
         virtual SNorm* getAccumulation() const;
 
+        /**
+         * When grouping by term and accumulating with Maximum, adding a term
+         * already activated (by the same activation operator) accumulates its
+         * degree into the existing activated term instead of adding another
+         * one, so the cost of membership() grows with the number of terms
+         * instead of the number of rules fired, and the result is the same.
+         * Other accumulations do not group, since the membership would change
+         * (WeightedDefuzzifiers already accumulate the degrees by term).
+         */
+        virtual void setGroupByTerm(bool groupByTerm);
+        virtual bool isGroupedByTerm() const;
+
         /**
          * Operations for std::vector _terms
          */
-        virtual void addTerm(const Term* term, scalar degree, const TNorm* activation);
+        virtual Activated* addTerm(const Term* term, scalar degree, const TNorm* activation);
         virtual void addTerm(Activated* term);
         virtual Activated* getTerm(int index) const;
         virtual Activated* removeTerm(int index);
@@ -88,6 +109,9 @@ namespace fl {
         virtual std::vector<Activated*>& terms();
         virtual bool isEmpty() const;
         virtual void clear();
+        //Preallocates activated terms such that adding up to the given number
+        //of terms does not allocate memory
+        virtual void reserve(int numberOfTerms);
     };
 
 }
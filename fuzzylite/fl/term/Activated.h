@@ -35,6 +35,11 @@ namespace fl {
         const Term* _term;
         scalar _degree;
         const TNorm* _activation;
+        Context* _context;
+        int _termIndex;
+
+        //Activates the memberships y[i] of the term with the degree, one block at a time
+        virtual void activate(const scalar* x, scalar* y, std::size_t n) const;
 
     public:
         explicit Activated(const Term* term = fl::null, scalar degree = 1.0,
@@ -43,10 +48,17 @@ namespace fl {
         FL_DEFAULT_COPY_AND_MOVE(Activated)
 
         virtual std::string className() const FL_IOVERRIDE;
+        //The name of the term, which is not copied to reuse activated terms without allocating
+        virtual std::string getName() const FL_IOVERRIDE;
         virtual std::string parameters() const FL_IOVERRIDE;
         virtual void configure(const std::string& parameters) FL_IOVERRIDE;
 
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual void support(scalar& minimum, scalar& maximum) const FL_IOVERRIDE;
+        virtual scalar membership(scalar x, const Context& context) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n,
+                const Context& context) const FL_IOVERRIDE;
         virtual std::string toString() const FL_IOVERRIDE;
 
         virtual void setTerm(const Term* term);
@@ -58,6 +70,13 @@ namespace fl {
         virtual void setActivation(const TNorm* activation);
         virtual const TNorm* getActivation() const;
 
+        virtual void setContext(Context* context);
+        virtual Context* getContext() const;
+
+        //Index of the term in its output variable, or -1 if unknown
+        virtual void setTermIndex(int termIndex);
+        virtual int getTermIndex() const;
+
         virtual Activated* clone() const FL_IOVERRIDE;
     };
 
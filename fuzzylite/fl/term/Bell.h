@@ -47,7 +47,9 @@ namespace fl {
         virtual std::string parameters() const FL_IOVERRIDE;
         virtual void configure(const std::string& parameters) FL_IOVERRIDE;
 
+        using Term::membership;
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
 
         virtual void setCenter(scalar center);
         virtual scalar getCenter() const;
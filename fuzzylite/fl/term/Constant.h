@@ -43,7 +43,10 @@ namespace fl {
         virtual std::string parameters() const FL_IOVERRIDE;
         virtual void configure(const std::string& parameters) FL_IOVERRIDE;
 
+        using Term::membership;
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+        virtual bool isTakagiSugeno() const FL_IOVERRIDE;
 
         virtual void setValue(scalar value);
         virtual scalar getValue() const;
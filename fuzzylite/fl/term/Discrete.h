@@ -37,6 +37,14 @@ namespace fl {
         typedef std::pair<scalar, scalar> Pair;
     protected:
         std::vector<Pair> _xy;
+        bool _sorted;
+        bool _uniform;
+
+        //Index of the first pair whose x is greater than x, starting from the hint
+        virtual std::size_t upperBound(scalar x, std::size_t hint) const;
+        //Membership of x within the sorted pairs, given the upper bound of x
+        virtual scalar interpolate(scalar x, std::size_t upper) const;
+
     public:
         explicit Discrete(const std::string& name = "",
                 const std::vector<Pair>& xy = std::vector<Pair>(),
@@ -53,7 +61,19 @@ namespace fl {
         static Discrete* create(const std::string& name, int argc,
                 T x1, T y1, ...); // throw (fl::Exception);
 
+        using Term::membership;
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+
+        /**
+         * Detects whether the pairs are sorted by x, such that membership
+         * searches them in O(log n), or O(1) if they are also equally spaced.
+         * The non-const accessors of the pairs disable the searches (falling
+         * back to scanning the pairs) until this method is called again.
+         */
+        virtual void updateIndex();
+        virtual bool isSorted() const;
+        virtual bool isUniform() const;
 
         virtual void setXY(const std::vector<Pair>& pairs);
         virtual const std::vector<Pair>& xy() const;
@@ -29,10 +29,14 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace fl {
 
     class Engine;
+    class Context;
+    class InputVariable;
+    class OutputVariable;
 
     class FL_API Function : public Term {
         /****************************
@@ -108,6 +112,33 @@ namespace fl {
 
 
 
+        /**
+         * Instruction of the postfix program to which the formula is compiled
+         * when the function is loaded. Constants and variables push their value
+         * onto a stack, and unary and binary elements replace their arguments
+         * on top of the stack with their result. The variables of the engine
+         * are resolved to their indices, so their values are read from the
+         * engine (or the context) without looking up their names. Subtrees
+         * without variables are folded into constants, and the result of a
+         * subtree that appears more than once is stored in a register the
+         * first time and loaded thereafter (elements are assumed to be pure).
+         */
+        struct FL_API Instruction {
+
+            enum Opcode {
+                Constant, ValueOfX, InputValue, OutputValue, MappedValue,
+                UnaryElement, BinaryElement, StoreResult, LoadResult
+            };
+            Opcode opcode;
+            scalar value;
+            int index;
+            std::string variable;
+            Unary unary;
+            Binary binary;
+
+            explicit Instruction(Opcode opcode = Constant);
+        };
+
         /******************************
          * Term
          ******************************/
@@ -116,6 +147,32 @@ namespace fl {
         FL_unique_ptr<Node> _root;
         std::string _formula;
         const Engine* _engine;
+        std::vector<Instruction> _instructions;
+        std::size_t _stackSize;
+        std::size_t _registers;
+        //Input and output variables of the engine when compiled
+        std::vector<InputVariable*> _compiledInputs;
+        std::vector<OutputVariable*> _compiledOutputs;
+        bool _monotonic;
+
+        virtual void compile();
+        virtual void compile(const Node* node, std::vector<Instruction>& instructions,
+                std::map<std::string, int>& occurrences,
+                std::map<std::string, int>& registers) const;
+        //Identifies the subtree of the node, and counts the occurrences of its subtrees
+        virtual std::string subtreeKey(const Node* node,
+                std::map<std::string, int>* occurrences = fl::null) const;
+        //Evaluates the program using the values of the context, or of the engine if none
+        virtual scalar execute(scalar x, const Context* context) const;
+        /**
+         * Evaluates the program on n rows, where the variables without columns
+         * take the values of the context in every row, or of the engine if none
+         */
+        virtual void execute(const scalar* x, const scalar* const* inputValues,
+                const scalar* const* outputValues, scalar* y, std::size_t n,
+                const Context* context) const;
+        //Evaluates the tree resolving the variables by name in the context
+        virtual scalar interpret(const Node* node, scalar x, const Context& context) const;
     public:
         mutable std::map<std::string, scalar> variables;
         explicit Function(const std::string& name = "",
@@ -130,9 +187,41 @@ namespace fl {
                 const Engine* engine = fl::null); // throw (fl::Exception);
 
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual scalar membership(scalar x, const Context& context) const FL_IOVERRIDE;
 
         virtual scalar evaluate(const std::map<std::string, scalar>* variables) const;
 
+        /**
+         * Evaluates the function on n rows at once, one instruction at a time
+         * over blocks of rows: x[i] is the value of x of row i, and
+         * inputValues[v][i] (or outputValues[v][i]) is the value of the v-th
+         * input (or output) variable of the engine in row i. If inputValues
+         * (or outputValues) is null, the current values of the variables are
+         * used in every row.
+         */
+        virtual void evaluate(const scalar* x, const scalar* const* inputValues,
+                const scalar* const* outputValues, scalar* y, std::size_t n) const;
+        //Membership of n values of x, using the current values of the variables
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n,
+                const Context& context) const FL_IOVERRIDE;
+
+        /**
+         * A function declared monotonic is a membership function that Tsukamoto
+         * inverts numerically. Otherwise, the function gives the output value
+         * as in Takagi-Sugeno and inverse Tsukamoto.
+         */
+        virtual void setMonotonic(bool monotonic);
+        virtual bool isMonotonic() const FL_IOVERRIDE;
+        virtual bool isTakagiSugeno() const FL_IOVERRIDE;
+        virtual bool dependsOnVariables() const FL_IOVERRIDE;
+        /**
+         * Whether the compiled program reads neither x nor the output
+         * variables, such that the function can be evaluated on the input
+         * values of many rows before any of them is activated
+         */
+        virtual bool dependsOnlyOnInputs() const;
+
         virtual std::string className() const FL_IOVERRIDE;
         virtual std::string parameters() const FL_IOVERRIDE;
         virtual void configure(const std::string& parameters) FL_IOVERRIDE;
@@ -144,8 +233,15 @@ namespace fl {
         virtual const Engine* getEngine() const;
 
         virtual Node* root() const;
+        virtual const std::vector<Instruction>& instructions() const;
 
         virtual bool isLoaded() const;
+        /**
+         * Whether the program is compiled for the current variables of the
+         * engine, which must be the same (and in the same order) as when
+         * compiled, and keep the names by which the formula refers to them
+         */
+        virtual bool isCompiled() const;
         virtual void unload();
         virtual void load(); // throw (fl::Exception);
         virtual void load(const std::string& formula); // throw (fl::Exception);
@@ -46,6 +46,19 @@ namespace fl {
         virtual void configure(const std::string& parameters) FL_IOVERRIDE;
 
         virtual scalar membership(scalar x) const FL_IOVERRIDE;
+        virtual scalar membership(scalar x, const Context& context) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n,
+                const Context& context) const FL_IOVERRIDE;
+        virtual bool isTakagiSugeno() const FL_IOVERRIDE;
+        virtual bool dependsOnVariables() const FL_IOVERRIDE;
+        /**
+         * Evaluates the term on n rows at once, one coefficient at a time over
+         * all the rows: inputValues[v][i] is the value of the v-th input
+         * variable of the engine in row i. If inputValues is null, the current
+         * values of the input variables are used in every row.
+         */
+        virtual void evaluate(const scalar* const* inputValues, scalar* y, std::size_t n) const;
 
         virtual void set(const std::vector<scalar>& coeffs, const Engine* engine);
 
@@ -36,6 +36,7 @@
 
 namespace fl {
     class Engine;
+    class Context;
 
     class FL_API Term {
     protected:
@@ -60,6 +61,30 @@ namespace fl {
         virtual void configure(const std::string& parameters) = 0;
 
         virtual scalar membership(scalar x) const = 0;
+        //Membership of terms that depend on the values of variables, evaluated from the context
+        virtual scalar membership(scalar x, const Context& context) const;
+        //Memberships y[i] of the n values x[i], which equal those of membership(x[i]) and of
+        //membership(x[i], context), respectively, without a virtual call per value
+        virtual void membership(const scalar* x, scalar* y, std::size_t n) const;
+        virtual void membership(const scalar* x, scalar* y, std::size_t n, const Context& context) const;
+        //Interval outside of which the membership is zero: [-inf, inf] if unbounded,
+        //and empty (minimum > maximum) if the membership is zero everywhere
+        virtual void support(scalar& minimum, scalar& maximum) const;
+
+        //Whether the membership function is monotonic, as required by Tsukamoto
+        virtual bool isMonotonic() const;
+        //Whether the membership function gives the output value, as in Takagi-Sugeno (e.g., Constant, Linear)
+        virtual bool isTakagiSugeno() const;
+        //Whether the membership function depends on the values of the variables (e.g., Linear, Function)
+        virtual bool dependsOnVariables() const;
+        /**
+         * Tsukamoto finds the value z in [minimum, maximum] such that
+         * membership(z) equals the activation degree. Monotonic terms find z
+         * numerically unless they override this method with their inverse,
+         * and the other terms return membership(activationDegree), which
+         * provides Takagi-Sugeno and inverse Tsukamoto (e.g., with a Function)
+         */
+        virtual scalar tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const;
 
         virtual Term* clone() const = 0;
         
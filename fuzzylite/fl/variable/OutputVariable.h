@@ -26,10 +26,14 @@
 #define FL_OUTPUTVARIABLE_H
 
 #include "fl/variable/Variable.h"
+#include "fl/defuzzifier/IntegralDefuzzifier.h"
+
+#include <utility>
 
 namespace fl {
     class Accumulated;
     class Defuzzifier;
+    class Context;
 
     class FL_API OutputVariable : public Variable {
     private:
@@ -42,6 +46,10 @@ namespace fl {
         scalar _defaultValue;
         bool _lockOutputValueInRange;
         bool _lockPreviousOutputValue;
+        std::vector<std::vector<scalar> > _sampledTerms;
+        std::vector<std::pair<int, int> > _sampledSupports;
+
+        virtual bool accumulate(const Accumulated* fuzzyOutput, std::vector<scalar>& samples) const;
 
     public:
         explicit OutputVariable(const std::string& name = "",
@@ -77,6 +85,24 @@ namespace fl {
         virtual bool isLockedPreviousOutputValue() const;
 
         virtual void defuzzify();
+        //Defuzzifies the fuzzy output of this variable at the given index of the context
+        virtual void defuzzify(Context& context, int index) const;
+        /**
+         * Samples the fuzzy output at the given index of the context once and
+         * computes every integral defuzzification from those samples, at the
+         * resolution of the defuzzifier if it is an IntegralDefuzzifier
+         */
+        virtual IntegralDefuzzifier::Sweep sweep(Context& context, int index) const;
+
+        /**
+         * Samples the terms at the resolution of the integral defuzzifier, such
+         * that defuzzifying from a context accumulates the fuzzy output on
+         * arrays instead of computing the membership of each activated term at
+         * every point. The terms must be sampled again after they change.
+         */
+        virtual void sampleTerms();
+        virtual void clearSampledTerms();
+        virtual bool hasSampledTerms() const;
 
         virtual std::string fuzzyOutputValue() const;
 
@@ -44,6 +44,7 @@ namespace fl {
         std::vector<Term*> _terms;
         scalar _minimum, _maximum;
         bool _enabled;
+        unsigned long _revision;
 
     public:
         explicit Variable(const std::string& name = "",
@@ -77,6 +78,9 @@ namespace fl {
         /**
          * Operations for iterable datatype _terms
          */
+        //Changes whenever terms are added, removed or reordered (see Engine::revision())
+        virtual unsigned long revision() const;
+
         virtual void sort();
         virtual void addTerm(Term* term);
         virtual void insertTerm(Term* term, int index);
@@ -87,6 +91,7 @@ namespace fl {
         virtual int numberOfTerms() const;
         virtual void setTerms(const std::vector<Term*>& terms);
         virtual const std::vector<Term*>& terms() const;
+        //Edits made through the vector must be followed by Engine::restart()
         virtual std::vector<Term*>& terms();
 
     };
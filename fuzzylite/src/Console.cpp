@@ -28,7 +28,11 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <stdlib.h>
 #include <utility>
 #include <vector>
@@ -55,19 +59,29 @@ namespace fl {
     const std::string Console::KW_DATA_MAXIMUM = "-dmaximum";
     const std::string Console::KW_DATA_EXPORT_HEADER = "-dheader";
     const std::string Console::KW_DATA_EXPORT_INPUTS = "-dinputs";
+    const std::string Console::KW_DATA_THREADS = "-dthreads";
+    const std::string Console::KW_DATA_PRECISION = "-dprecision";
+    const std::string Console::KW_BENCHMARK = "-benchmark";
+    const std::string Console::KW_BENCHMARK_WARMUP = "-bwarmup";
+    const std::string Console::KW_BENCHMARK_FORMAT = "-bformat";
 
     std::vector<Console::Option> Console::availableOptions() {
         std::vector<Console::Option> options;
         options.push_back(Option(KW_INPUT_FILE, "inputfile", "file to import your engine from"));
         options.push_back(Option(KW_INPUT_FORMAT, "format", "format of the file to import (fll | fis | fcl)"));
         options.push_back(Option(KW_OUTPUT_FILE, "outputfile", "file to export your engine to"));
-        options.push_back(Option(KW_OUTPUT_FORMAT, "format", "format of the file to export (fll | fld | cpp | java | fis | fcl)"));
+        options.push_back(Option(KW_OUTPUT_FORMAT, "format", "format of the file to export (fll | fld | flb | cpp | java | fis | fcl)"));
         options.push_back(Option(KW_EXAMPLE, "letter", "if not inputfile, built-in example to use as engine: (m)amdani or (t)akagi-sugeno"));
         options.push_back(Option(KW_DECIMALS, "number", "number of decimals to write floating-poing values"));
-        options.push_back(Option(KW_DATA_INPUT, "datafile", "if exporting to fld, file of input values to evaluate your engine on"));
-        options.push_back(Option(KW_DATA_MAXIMUM, "number", "if exporting to fld without datafile, maximum number of results to export"));
+        options.push_back(Option(KW_DATA_INPUT, "datafile", "if exporting to fld or flb, file of input values (fld or flb) to evaluate your engine on"));
+        options.push_back(Option(KW_DATA_MAXIMUM, "number", "if exporting to fld or flb without datafile, maximum number of results to export"));
         options.push_back(Option(KW_DATA_EXPORT_HEADER, "boolean", "if true and exporting to fld, include headers"));
-        options.push_back(Option(KW_DATA_EXPORT_INPUTS, "boolean", "if true and exporting to fld, include input values"));
+        options.push_back(Option(KW_DATA_EXPORT_INPUTS, "boolean", "if true and exporting to fld or flb, include input values"));
+        options.push_back(Option(KW_DATA_THREADS, "number", "if exporting to fld, number of threads to evaluate the engine with"));
+        options.push_back(Option(KW_DATA_PRECISION, "precision", "if exporting to flb, precision of the values (single | double)"));
+        options.push_back(Option(KW_BENCHMARK, "number", "instead of exporting, number of runs to time the engine on the datafile or on -dmaximum values"));
+        options.push_back(Option(KW_BENCHMARK_WARMUP, "number", "if benchmarking, number of runs before timing (default 1)"));
+        options.push_back(Option(KW_BENCHMARK_FORMAT, "format", "if benchmarking, format of the results (text | tsv)"));
         return options;
     }
 
@@ -211,6 +225,24 @@ namespace fl {
             outputFilename = it->second;
         }
 
+        if (options.find(KW_BENCHMARK) != options.end()) {
+#ifdef FL_CPP11
+            if (outputFilename.empty()) {
+                benchmark(textEngine.str(), inputFormat, std::cout, options);
+            } else {
+                std::ofstream writer(outputFilename.c_str());
+                if (not writer.is_open()) {
+                    throw fl::Exception("[file error] file <" + outputFilename + "> could not be created", FL_AT);
+                }
+                benchmark(textEngine.str(), inputFormat, writer, options);
+                writer.close();
+            }
+            return;
+#else
+            throw fl::Exception("[benchmark error] implementation available only when built with C++11 (-DFL_CPP11)", FL_AT);
+#endif
+        }
+
         std::string outputFormat;
         it = options.find(KW_OUTPUT_FORMAT);
         if (it != options.end()) {
@@ -228,7 +260,9 @@ namespace fl {
         if (outputFilename.empty()) {
             process(textEngine.str(), std::cout, inputFormat, outputFormat, options);
         } else {
-            std::ofstream writer(outputFilename.c_str());
+            std::ios::openmode mode = std::ios::out;
+            if ("flb" == outputFormat) mode |= std::ios::binary;
+            std::ofstream writer(outputFilename.c_str(), mode);
             if (not writer.is_open()) {
                 throw fl::Exception("[file error] file <" + outputFilename + "> could not be created", FL_AT);
             }
@@ -241,21 +275,10 @@ namespace fl {
     void Console::process(const std::string& input, std::ostream& writer,
             const std::string& inputFormat, const std::string& outputFormat,
             const std::map<std::string, std::string>& options) {
-        FL_unique_ptr<Importer> importer;
+        FL_unique_ptr<Importer> importer(createImporter(inputFormat));
         FL_unique_ptr<Exporter> exporter;
         FL_unique_ptr<Engine> engine;
 
-        if ("fll" == inputFormat) {
-            importer.reset(new FllImporter);
-        } else if ("fcl" == inputFormat) {
-            importer.reset(new FclImporter);
-        } else if ("fis" == inputFormat) {
-            importer.reset(new FisImporter);
-        } else {
-            throw fl::Exception("[import error] format <" + inputFormat + "> "
-                    "not supported", FL_AT);
-        }
-
         engine.reset(importer->fromString(input));
 
         if ("fld" == outputFormat) {
@@ -273,8 +296,11 @@ namespace fl {
                 exportInputValues = ("true" == it->second);
             }
             fldExporter.setExportInputValues(exportInputValues);
+            if ((it = options.find(KW_DATA_THREADS)) != options.end()) {
+                fldExporter.setThreads((int) fl::Op::toScalar(it->second));
+            }
             if ((it = options.find(KW_DATA_INPUT)) != options.end()) {
-                std::ifstream dataFile(it->second.c_str());
+                std::ifstream dataFile(it->second.c_str(), std::ios::in | std::ios::binary);
                 if (not dataFile.is_open()) {
                     throw fl::Exception("[export error] file <" + it->second + "> could not be opened", FL_AT);
                 }
@@ -300,6 +326,33 @@ namespace fl {
                     interactive(writer, engine.get());
                 }
             }
+        } else if ("flb" == outputFormat) {
+            std::map<std::string, std::string>::const_iterator it;
+
+            FlbExporter flbExporter;
+            if ((it = options.find(KW_DATA_EXPORT_INPUTS)) != options.end()) {
+                flbExporter.setExportInputValues("true" == it->second);
+            }
+            if ((it = options.find(KW_DATA_PRECISION)) != options.end()) {
+                if (not ("single" == it->second or "double" == it->second)) {
+                    throw fl::Exception("[option error] precision <" + it->second + "> "
+                            "not supported, only single or double", FL_AT);
+                }
+                flbExporter.setSinglePrecision("single" == it->second);
+            }
+            if ((it = options.find(KW_DATA_INPUT)) != options.end()) {
+                std::ifstream dataFile(it->second.c_str(), std::ios::in | std::ios::binary);
+                if (not dataFile.is_open()) {
+                    throw fl::Exception("[export error] file <" + it->second + "> could not be opened", FL_AT);
+                }
+                flbExporter.write(engine.get(), writer, dataFile);
+            } else {
+                int maximum = 1024;
+                if ((it = options.find(KW_DATA_MAXIMUM)) != options.end()) {
+                    maximum = (int) fl::Op::toScalar(it->second);
+                }
+                flbExporter.write(engine.get(), writer, maximum);
+            }
         } else {
             if ("fll" == outputFormat) {
                 exporter.reset(new FllExporter);
@@ -317,6 +370,14 @@ namespace fl {
         }
     }
 
+    Importer* Console::createImporter(const std::string& format) {
+        if ("fll" == format) return new FllImporter;
+        if ("fcl" == format) return new FclImporter;
+        if ("fis" == format) return new FisImporter;
+        throw fl::Exception("[import error] format <" + format + "> "
+                "not supported", FL_AT);
+    }
+
     int Console::readCharacter() {
         int ch = 0;
 #ifdef FL_UNIX
@@ -749,6 +810,148 @@ namespace fl {
                     Op::join(seconds, "\t"));
         }
     }
+
+    void Console::benchmark(const std::string& input, const std::string& inputFormat,
+            std::ostream& writer, const std::map<std::string, std::string>& options) {
+        typedef std::chrono::steady_clock Clock;
+        std::map<std::string, std::string>::const_iterator it;
+
+        int runs = (int) Op::toScalar(options.find(KW_BENCHMARK)->second);
+        int warmup = 1;
+        if ((it = options.find(KW_BENCHMARK_WARMUP)) != options.end()) {
+            warmup = (int) Op::toScalar(it->second);
+        }
+        if (runs < 1 or warmup < 0) {
+            throw fl::Exception("[option error] benchmark needs a positive number of runs "
+                    "and a non-negative number of warm-up runs", FL_AT);
+        }
+        std::string format = "text";
+        if ((it = options.find(KW_BENCHMARK_FORMAT)) != options.end()) {
+            format = it->second;
+        }
+        if (not ("text" == format or "tsv" == format)) {
+            throw fl::Exception("[option error] benchmark format <" + format + "> "
+                    "not supported, only text or tsv", FL_AT);
+        }
+
+        Clock::time_point importStart = Clock::now();
+        FL_unique_ptr<Importer> importer(createImporter(inputFormat));
+        FL_unique_ptr<Engine> engine(importer->fromString(input));
+        scalar importTime = scalar(std::chrono::duration<double>(Clock::now() - importStart).count());
+
+        //the rows of input values are stored one after the other
+        const int inputs = engine->numberOfInputVariables();
+        std::vector<scalar> values;
+        std::size_t rows = 0;
+        std::ifstream dataFile;
+        FL_unique_ptr<DataReader> data;
+        if ((it = options.find(KW_DATA_INPUT)) != options.end()) {
+            dataFile.open(it->second.c_str(), std::ios::in | std::ios::binary);
+            if (not dataFile.is_open()) {
+                throw fl::Exception("[benchmark error] file <" + it->second + "> could not be opened", FL_AT);
+            }
+            data.reset(new DataReader(engine.get(), dataFile));
+        } else {
+            int maximum = 1024;
+            if ((it = options.find(KW_DATA_MAXIMUM)) != options.end()) {
+                maximum = (int) Op::toScalar(it->second);
+            }
+            data.reset(new DataReader(engine.get(), maximum));
+        }
+        std::vector<scalar> block;
+        std::size_t blockRows;
+        while ((blockRows = data->read(block, 4096)) > 0) {
+            for (std::size_t row = 0; row < blockRows; ++row) {
+                for (int i = 0; i < inputs; ++i) {
+                    values.push_back(block.at(i * blockRows + row));
+                }
+            }
+            rows += blockRows;
+        }
+        if (rows == 0) {
+            throw fl::Exception("[benchmark error] no input values to evaluate the engine on", FL_AT);
+        }
+        for (int i = 0; i < inputs; ++i) {
+            if (engine->getInputVariable(i)->isEnabled()) continue;
+            for (std::size_t row = 0; row < rows; ++row) values.at(row * inputs + i) = fl::nan;
+        }
+
+        //every evaluation is timed by the phases of Engine::process(Context&)
+        Context context(engine.get());
+        std::vector<double> latencies;
+        latencies.reserve(rows * runs);
+        Clock::duration inputTime = Clock::duration::zero(),
+                activationTime = Clock::duration::zero(),
+                defuzzificationTime = Clock::duration::zero(),
+                totalTime = Clock::duration::zero();
+        for (int run = -warmup; run < runs; ++run) {
+            const bool timed = (run >= 0);
+            Clock::time_point runStart = Clock::now();
+            for (std::size_t row = 0; row < rows; ++row) {
+                Clock::time_point start = Clock::now();
+                for (int i = 0; i < inputs; ++i) {
+                    context.setInputValue(i, values[row * inputs + i]);
+                }
+                Clock::time_point inputEnd = Clock::now();
+                engine->activate(context);
+                Clock::time_point activationEnd = Clock::now();
+                engine->defuzzify(context);
+                Clock::time_point end = Clock::now();
+                if (timed) {
+                    inputTime += inputEnd - start;
+                    activationTime += activationEnd - inputEnd;
+                    defuzzificationTime += end - activationEnd;
+                    latencies.push_back(std::chrono::duration<double>(end - start).count());
+                }
+            }
+            if (timed) totalTime += Clock::now() - runStart;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        const double percentiles[] = {0.5, 0.99, 0.999};
+        std::vector<scalar> latency; //in microseconds, by nearest rank
+        for (int i = 0; i < 3; ++i) {
+            std::size_t rank = (std::size_t) std::ceil(percentiles[i] * latencies.size());
+            latency.push_back(scalar(1e6 * latencies.at(std::max(std::size_t(1), rank) - 1)));
+        }
+        const std::size_t evaluations = latencies.size();
+        const double seconds = std::chrono::duration<double>(totalTime).count();
+        const scalar throughput = scalar(evaluations / seconds);
+        std::vector<scalar> phases; //mean microseconds per evaluation
+        phases.push_back(scalar(1e6 * std::chrono::duration<double>(inputTime).count() / evaluations));
+        phases.push_back(scalar(1e6 * std::chrono::duration<double>(activationTime).count() / evaluations));
+        phases.push_back(scalar(1e6 * std::chrono::duration<double>(defuzzificationTime).count() / evaluations));
+        const scalar phasesTime = phases.at(0) + phases.at(1) + phases.at(2);
+        const char* phaseNames[] = {"inputs", "activation", "defuzzification"};
+
+        if ("tsv" == format) {
+            //the seconds are written at full precision for the results to be compared
+            std::ostringstream exactSeconds;
+            exactSeconds << std::setprecision(std::numeric_limits<double>::max_digits10) << seconds;
+            writer << "#engine\trows\twarmup\truns\tevaluations\tseconds\tevaluations/s\t"
+                    "p50(us)\tp99(us)\tp99.9(us)\tinputs(us)\tactivation(us)\tdefuzzification(us)\timport(ms)\n";
+            writer << engine->getName() << "\t" << rows << "\t" << warmup << "\t" << runs << "\t"
+                    << evaluations << "\t" << exactSeconds.str() << "\t"
+                    << Op::str(throughput) << "\t" << Op::join(latency, "\t") << "\t"
+                    << Op::join(phases, "\t") << "\t" << Op::str(1e3 * importTime) << "\n";
+            return;
+        }
+        writer << "#FuzzyLite Benchmark\n"
+                << "engine           " << engine->getName() << " (" << inputFormat << ", imported in "
+                << Op::str(1e3 * importTime) << " ms)\n"
+                << "rows             " << rows << " of " << inputs << " input values\n"
+                << "runs             " << runs << " timed after " << warmup << " warm-up\n"
+                << "evaluations      " << evaluations << " in " << Op::str(scalar(seconds)) << " s\n"
+                << "throughput       " << Op::str(throughput) << " evaluations/s\n"
+                << "latency          p50 " << Op::str(latency.at(0)) << " us, p99 " << Op::str(latency.at(1))
+                << " us, p99.9 " << Op::str(latency.at(2)) << " us\n";
+        for (int i = 0; i < 3; ++i) {
+            std::string spacedPhase(17, ' ');
+            std::copy(phaseNames[i], phaseNames[i] + std::strlen(phaseNames[i]), spacedPhase.begin());
+            writer << spacedPhase << Op::str(phases.at(i)) << " us ("
+                    << Op::str(scalar(phasesTime > 0.0 ? 100.0 * phases.at(i) / phasesTime : 0.0)) << "%)\n";
+        }
+    }
 #endif
 
     int Console::main(int argc, char** argv) {
@@ -0,0 +1,348 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "fl/Context.h"
+
+#include "fl/Engine.h"
+#include "fl/rule/Consequent.h"
+#include "fl/rule/Expression.h"
+#include "fl/rule/Rule.h"
+#include "fl/rule/RuleBlock.h"
+#include "fl/term/Accumulated.h"
+#include "fl/variable/InputVariable.h"
+#include "fl/variable/OutputVariable.h"
+
+#include <algorithm>
+
+namespace fl {
+
+    Context::Context(const Engine* engine) : _engine(fl::null), _sharesFuzzyOutputs(false), _revision(0) {
+        if (engine) load(engine);
+    }
+
+    Context::Context(const Context& other) : _engine(fl::null), _sharesFuzzyOutputs(false), _revision(0) {
+        copyFrom(other);
+    }
+
+    Context& Context::operator=(const Context& other) {
+        if (this != &other) {
+            unload();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    Context::~Context() {
+        unload();
+    }
+
+#ifdef FL_CPP11
+
+    Context::Context(Context&& other) : _engine(fl::null), _sharesFuzzyOutputs(false), _revision(0) {
+        swap(other);
+    }
+
+    Context& Context::operator=(Context&& other) {
+        if (this != &other) {
+            unload();
+            swap(other);
+        }
+        return *this;
+    }
+#endif
+
+    void Context::swap(Context& other) {
+        std::swap(_engine, other._engine);
+        _inputValues.swap(other._inputValues);
+        _memberships.swap(other._memberships);
+        _outputValues.swap(other._outputValues);
+        _previousOutputValues.swap(other._previousOutputValues);
+        _fuzzyOutputs.swap(other._fuzzyOutputs);
+        _samples.swap(other._samples);
+        _weights.swap(other._weights);
+        _grids.swap(other._grids);
+        _buffer.swap(other._buffer);
+        _discrete.xy().swap(other._discrete.xy());
+        std::swap(_sharesFuzzyOutputs, other._sharesFuzzyOutputs);
+        std::swap(_revision, other._revision);
+    }
+
+    void Context::copyFrom(const Context& other) {
+        _engine = other._engine;
+        _inputValues = other._inputValues;
+        _memberships = other._memberships;
+        _outputValues = other._outputValues;
+        _previousOutputValues = other._previousOutputValues;
+        _samples = other._samples;
+        _weights = other._weights;
+        _grids = other._grids;
+        _sharesFuzzyOutputs = other._sharesFuzzyOutputs;
+        _revision = other._revision;
+        for (std::size_t i = 0; i < other._fuzzyOutputs.size(); ++i) {
+            Accumulated* fuzzyOutput = other._fuzzyOutputs.at(i);
+            _fuzzyOutputs.push_back(_sharesFuzzyOutputs ? fuzzyOutput : fuzzyOutput->clone());
+        }
+    }
+
+    void Context::load(const Engine* engine, bool shareFuzzyOutputs) {
+        unload();
+        this->_engine = engine;
+        this->_sharesFuzzyOutputs = shareFuzzyOutputs;
+        if (not engine) return;
+
+        this->_revision = engine->revision();
+        _inputValues.resize(engine->inputVariables().size());
+        std::size_t numberOfTerms = 0;
+        for (std::size_t i = 0; i < engine->inputVariables().size(); ++i) {
+            numberOfTerms += engine->inputVariables().at(i)->numberOfTerms();
+        }
+        _memberships.resize(numberOfTerms);
+        _outputValues.resize(engine->outputVariables().size());
+        _previousOutputValues.resize(engine->outputVariables().size());
+        _samples.resize(engine->outputVariables().size());
+        _weights.resize(engine->outputVariables().size());
+        for (std::size_t i = 0; i < engine->outputVariables().size(); ++i) {
+            const OutputVariable* outputVariable = engine->outputVariables().at(i);
+            Weights& weights = _weights.at(i);
+            weights.degrees.resize(outputVariable->numberOfTerms());
+            weights.first.resize(outputVariable->numberOfTerms());
+            weights.values.resize(outputVariable->numberOfTerms(), fl::nan);
+            for (int t = 0; t < outputVariable->numberOfTerms(); ++t) {
+                weights.takagiSugeno.push_back(outputVariable->getTerm(t)->isTakagiSugeno());
+                weights.monotonic.push_back(outputVariable->getTerm(t)->isMonotonic());
+            }
+            Accumulated* fuzzyOutput = engine->outputVariables().at(i)->fuzzyOutput();
+            if (shareFuzzyOutputs) {
+                _fuzzyOutputs.push_back(fuzzyOutput);
+            } else {
+                fuzzyOutput = fuzzyOutput->clone();
+                fuzzyOutput->clear();
+                _fuzzyOutputs.push_back(fuzzyOutput);
+            }
+        }
+
+        //Preallocates an activated term per conclusion on each output variable
+        std::vector<int> conclusions(_fuzzyOutputs.size(), 0);
+        for (std::size_t b = 0; b < engine->ruleBlocks().size(); ++b) {
+            const RuleBlock* ruleBlock = engine->ruleBlocks().at(b);
+            for (std::size_t r = 0; r < ruleBlock->rules().size(); ++r) {
+                const Rule* rule = ruleBlock->rules().at(r);
+                if (not rule->isLoaded()) continue;
+                const std::vector<Proposition*>& propositions = rule->getConsequent()->conclusions();
+                for (std::size_t p = 0; p < propositions.size(); ++p) {
+                    for (std::size_t i = 0; i < engine->outputVariables().size(); ++i) {
+                        if (engine->outputVariables().at(i) == propositions.at(p)->variable)
+                            ++conclusions.at(i);
+                    }
+                }
+            }
+        }
+        for (std::size_t i = 0; i < _fuzzyOutputs.size(); ++i) {
+            _fuzzyOutputs.at(i)->reserve(conclusions.at(i));
+        }
+        restart();
+    }
+
+    void Context::unload() {
+        if (not _sharesFuzzyOutputs) {
+            for (std::size_t i = 0; i < _fuzzyOutputs.size(); ++i) {
+                delete _fuzzyOutputs.at(i);
+            }
+        }
+        _fuzzyOutputs.clear();
+        _inputValues.clear();
+        _memberships.clear();
+        _outputValues.clear();
+        _previousOutputValues.clear();
+        _samples.clear();
+        _weights.clear();
+        _grids.clear();
+        _buffer.clear();
+        _discrete.xy().clear();
+        _engine = fl::null;
+        _revision = 0;
+    }
+
+    bool Context::isLoaded(const Engine* engine) const {
+        return engine and engine == _engine and engine->revision() == _revision;
+    }
+
+    unsigned long Context::getRevision() const {
+        return this->_revision;
+    }
+
+    const Engine* Context::getEngine() const {
+        return this->_engine;
+    }
+
+    void Context::restart() {
+        std::fill(_inputValues.begin(), _inputValues.end(), fl::nan);
+        clearMemberships();
+        std::fill(_outputValues.begin(), _outputValues.end(), fl::nan);
+        std::fill(_previousOutputValues.begin(), _previousOutputValues.end(), fl::nan);
+        for (std::size_t i = 0; i < _fuzzyOutputs.size(); ++i) {
+            _fuzzyOutputs.at(i)->clear();
+        }
+    }
+
+    void Context::setInputValue(int index, scalar value) {
+        this->_inputValues.at(index) = value;
+    }
+
+    void Context::setInputValue(const std::string& name, scalar value) {
+        if (_engine) {
+            for (std::size_t i = 0; i < _engine->inputVariables().size(); ++i) {
+                if (_engine->inputVariables().at(i)->getName() == name) {
+                    this->_inputValues.at(i) = value;
+                    return;
+                }
+            }
+        }
+        throw fl::Exception("[context error] input variable <" + name + "> not found", FL_AT);
+    }
+
+    scalar Context::getInputValue(int index) const {
+        return this->_inputValues.at(index);
+    }
+
+    scalar Context::getInputValue(const InputVariable* inputVariable) const {
+        if (_engine) {
+            for (std::size_t i = 0; i < _engine->inputVariables().size(); ++i) {
+                if (_engine->inputVariables().at(i) == inputVariable)
+                    return this->_inputValues.at(i);
+            }
+        }
+        throw fl::Exception("[context error] input variable <" +
+                inputVariable->getName() + "> not found", FL_AT);
+    }
+
+    const std::vector<scalar>& Context::inputValues() const {
+        return this->_inputValues;
+    }
+
+    std::vector<scalar>& Context::inputValues() {
+        return this->_inputValues;
+    }
+
+    const std::vector<scalar>& Context::memberships() const {
+        return this->_memberships;
+    }
+
+    std::vector<scalar>& Context::memberships() {
+        return this->_memberships;
+    }
+
+    void Context::clearMemberships() {
+        std::fill(_memberships.begin(), _memberships.end(), fl::nan);
+    }
+
+    void Context::setOutputValue(int index, scalar value) {
+        this->_outputValues.at(index) = value;
+    }
+
+    scalar Context::getOutputValue(int index) const {
+        return this->_outputValues.at(index);
+    }
+
+    scalar Context::getOutputValue(const std::string& name) const {
+        if (_engine) {
+            for (std::size_t i = 0; i < _engine->outputVariables().size(); ++i) {
+                if (_engine->outputVariables().at(i)->getName() == name)
+                    return this->_outputValues.at(i);
+            }
+        }
+        throw fl::Exception("[context error] output variable <" + name + "> not found", FL_AT);
+    }
+
+    const std::vector<scalar>& Context::outputValues() const {
+        return this->_outputValues;
+    }
+
+    void Context::setPreviousOutputValue(int index, scalar value) {
+        this->_previousOutputValues.at(index) = value;
+    }
+
+    scalar Context::getPreviousOutputValue(int index) const {
+        return this->_previousOutputValues.at(index);
+    }
+
+    Accumulated* Context::fuzzyOutput(int index) const {
+        return this->_fuzzyOutputs.at(index);
+    }
+
+    Accumulated* Context::fuzzyOutput(const OutputVariable* outputVariable) const {
+        if (_engine) {
+            for (std::size_t i = 0; i < _engine->outputVariables().size(); ++i) {
+                if (_engine->outputVariables().at(i) == outputVariable)
+                    return this->_fuzzyOutputs.at(i);
+            }
+        }
+        throw fl::Exception("[context error] output variable <" +
+                outputVariable->getName() + "> not found", FL_AT);
+    }
+
+    int Context::numberOfFuzzyOutputs() const {
+        return this->_fuzzyOutputs.size();
+    }
+
+    Context::Weights* Context::weights(const Accumulated* fuzzyOutput) {
+        for (std::size_t i = 0; i < _fuzzyOutputs.size(); ++i) {
+            if (_fuzzyOutputs[i] == fuzzyOutput) return &_weights.at(i);
+        }
+        return fl::null;
+    }
+
+    std::vector<scalar>& Context::samples(int index) {
+        return this->_samples.at(index);
+    }
+
+    const std::vector<scalar>& Context::grid(scalar minimum, scalar maximum, int resolution) {
+        for (std::list<Grid>::const_iterator it = _grids.begin(); it != _grids.end(); ++it) {
+            const Grid& grid = *it;
+            if (grid.minimum == minimum and grid.maximum == maximum
+                    and int(grid.x.size()) == resolution) {
+                return grid.x;
+            }
+        }
+        Grid grid;
+        grid.minimum = minimum;
+        grid.maximum = maximum;
+        grid.x.resize(std::max(0, resolution));
+        scalar dx = (maximum - minimum) / resolution;
+        for (int i = 0; i < resolution; ++i) {
+            grid.x.at(i) = minimum + (i + 0.5) * dx;
+        }
+        _grids.push_back(grid);
+        return _grids.back().x;
+    }
+
+    std::vector<scalar>& Context::buffer() {
+        return this->_buffer;
+    }
+
+    Discrete& Context::discrete() {
+        return this->_discrete;
+    }
+
+}
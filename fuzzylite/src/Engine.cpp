@@ -26,6 +26,7 @@
 
 #include "fl/defuzzifier/WeightedAverage.h"
 #include "fl/defuzzifier/WeightedSum.h"
+#include "fl/defuzzifier/WeightedDefuzzifier.h"
 #include "fl/factory/DefuzzifierFactory.h"
 #include "fl/factory/FactoryManager.h"
 #include "fl/factory/SNormFactory.h"
@@ -33,6 +34,7 @@
 #include "fl/hedge/Hedge.h"
 #include "fl/imex/FllExporter.h"
 #include "fl/norm/t/AlgebraicProduct.h"
+#include "fl/rule/Antecedent.h"
 #include "fl/rule/Consequent.h"
 #include "fl/rule/Expression.h"
 #include "fl/rule/Rule.h"
@@ -48,13 +50,18 @@
 #include "fl/variable/InputVariable.h"
 #include "fl/variable/OutputVariable.h"
 
+#include <algorithm>
+
+#ifdef FL_CPP11
+#include <atomic>
+#endif
 
 namespace fl {
 
-    Engine::Engine(const std::string& name) : _name(name) {
+    Engine::Engine(const std::string& name) : _name(name), _revision(nextRevision()) {
     }
 
-    Engine::Engine(const Engine& other) : _name("") {
+    Engine::Engine(const Engine& other) : _name(""), _revision(nextRevision()) {
         copyFrom(other);
     }
 
@@ -69,6 +76,8 @@ namespace fl {
             for (std::size_t i = 0; i < _inputVariables.size(); ++i)
                 delete _inputVariables.at(i);
             _inputVariables.clear();
+            _context.reset(fl::null);
+            _revision = nextRevision();
 
             copyFrom(other);
         }
@@ -156,7 +165,7 @@ namespace fl {
             InputVariable* inputVariable = _inputVariables.at(i);
             if (not inputVariable) {
                 ss << "- Engine <" << _name << "> has a fl::null input variable at index <" << i << ">\n";
-            } else if (inputVariable->terms().empty()) {
+            } else if (inputVariable->numberOfTerms() == 0) {
                 //ignore because sometimes inputs can be empty: takagi-sugeno/matlab/slcpp1.fis
                 //                ss << "- Input variable <" << _inputVariables.at(i)->getName() << ">"
                 //                        << " has no terms\n";
@@ -171,7 +180,7 @@ namespace fl {
             if (not outputVariable) {
                 ss << "- Engine <" << _name << "> has a fl::null output variable at index <" << i << ">\n";
             } else {
-                if (outputVariable->terms().empty()) {
+                if (outputVariable->numberOfTerms() == 0) {
                     ss << "- Output variable <" << outputVariable->getName() << ">"
                             << " has no terms\n";
                 }
@@ -262,12 +271,58 @@ namespace fl {
         for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
             _outputVariables.at(i)->clear();
         }
+        //edits made through the references to the vectors are only known from here
+        this->_revision = nextRevision();
+        compile();
     }
 
-    void Engine::process() {
+    void Engine::compile() {
+        updateReferences();
+        for (std::size_t b = 0; b < _ruleblocks.size(); ++b) {
+            const std::vector<Rule*>& rules = _ruleblocks.at(b)->rules();
+            for (std::size_t r = 0; r < rules.size(); ++r) {
+                Rule* rule = rules.at(r);
+                if (not rule->isLoaded()) continue;
+                rule->getAntecedent()->compile(this);
+                rule->getConsequent()->compile(this);
+            }
+        }
+    }
+
+    unsigned long Engine::revision() const {
+        unsigned long result = _revision;
+        for (std::size_t i = 0; i < _inputVariables.size(); ++i) {
+            result = std::max(result, _inputVariables.at(i)->revision());
+        }
         for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
-            _outputVariables.at(i)->fuzzyOutput()->clear();
+            result = std::max(result, _outputVariables.at(i)->revision());
         }
+        return result;
+    }
+
+    unsigned long Engine::nextRevision() {
+#ifdef FL_CPP11
+        static std::atomic<unsigned long> revision(0);
+#else
+        static unsigned long revision = 0;
+#endif
+        return ++revision;
+    }
+
+    void Engine::sampleOutputTerms() {
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            _outputVariables.at(i)->sampleTerms();
+        }
+    }
+
+    void Engine::clearSampledOutputTerms() {
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            _outputVariables.at(i)->clearSampledTerms();
+        }
+    }
+
+    void Engine::process() {
+        Context& context = sharedContext();
 
         FL_DEBUG_BEGIN;
         FL_DBG("===============");
@@ -284,16 +339,11 @@ namespace fl {
         }
         FL_DEBUG_END;
 
-
-        for (std::size_t i = 0; i < _ruleblocks.size(); ++i) {
-            RuleBlock* ruleBlock = _ruleblocks.at(i);
-            if (ruleBlock->isEnabled()) {
-                ruleBlock->activate();
-            }
-        }
-
+        process(context);
         for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
-            _outputVariables.at(i)->defuzzify();
+            OutputVariable* outputVariable = _outputVariables.at(i);
+            outputVariable->setPreviousOutputValue(context.getPreviousOutputValue(i));
+            outputVariable->setOutputValue(context.getOutputValue(i));
         }
 
         FL_DEBUG_BEGIN;
@@ -324,6 +374,158 @@ namespace fl {
         FL_DEBUG_END;
     }
 
+    void Engine::process(const scalar* inputs, std::size_t rows, scalar* outputs) {
+        Context& context = sharedContext();
+        std::vector<scalar>& inputValues = context.inputValues();
+        std::vector<scalar>& memberships = context.memberships();
+
+        //Terms of the weighted output variables whose values depend only on the input values
+        std::vector<Context::Weights*> weights;
+        std::vector<int> termIndices;
+        std::vector<const Term*> terms;
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            OutputVariable* outputVariable = _outputVariables.at(i);
+            Context::Weights* grouped = context.weights(context.fuzzyOutput(i));
+            if (not (grouped and dynamic_cast<WeightedDefuzzifier*> (outputVariable->getDefuzzifier()))) {
+                continue;
+            }
+            for (int t = 0; t < outputVariable->numberOfTerms(); ++t) {
+                const Term* term = outputVariable->getTerm(t);
+                const Function* function = dynamic_cast<const Function*> (term);
+                if (grouped->monotonic[t] or not (dynamic_cast<const Linear*> (term)
+                        or (function and function->dependsOnlyOnInputs()))) {
+                    continue;
+                }
+                weights.push_back(grouped);
+                termIndices.push_back(t);
+                terms.push_back(term);
+            }
+        }
+
+        //The memberships of the input terms and the values of the terms above are
+        //evaluated column-wise over blocks of rows, which are then activated one by one
+        const std::size_t block = 128;
+        std::vector<scalar> membershipColumns(memberships.size() * block);
+        std::vector<scalar> valueColumns(terms.size() * block);
+        std::vector<const scalar*> inputColumns(_inputVariables.size());
+        try {
+            for (std::size_t start = 0; start < rows; start += block) {
+                const std::size_t size = std::min(block, rows - start);
+                std::size_t slot = 0;
+                for (std::size_t i = 0; i < _inputVariables.size(); ++i) {
+                    const InputVariable* inputVariable = _inputVariables.at(i);
+                    inputColumns[i] = inputs + i * rows + start;
+                    for (int t = 0; t < inputVariable->numberOfTerms(); ++t, ++slot) {
+                        const Term* term = inputVariable->getTerm(t);
+                        scalar* column = &membershipColumns[slot * block];
+                        if (inputVariable->isEnabled() and not term->dependsOnVariables()) {
+                            term->membership(inputColumns[i], column, size);
+                        } else {
+                            std::fill(column, column + size, fl::nan);
+                        }
+                    }
+                }
+                const scalar* const* columns = inputColumns.empty() ? fl::null : &inputColumns[0];
+                for (std::size_t k = 0; k < terms.size(); ++k) {
+                    scalar* column = &valueColumns[k * block];
+                    if (const Linear * linear = dynamic_cast<const Linear*> (terms[k])) {
+                        linear->evaluate(columns, column, size);
+                    } else {
+                        static_cast<const Function*> (terms[k])->evaluate(
+                                fl::null, columns, fl::null, column, size);
+                    }
+                }
+
+                for (std::size_t j = 0; j < size; ++j) {
+                    const std::size_t row = start + j;
+                    for (std::size_t i = 0; i < inputValues.size(); ++i) {
+                        inputValues[i] = inputs[i * rows + row];
+                    }
+                    for (std::size_t m = 0; m < memberships.size(); ++m) {
+                        memberships[m] = membershipColumns[m * block + j];
+                    }
+                    for (std::size_t k = 0; k < terms.size(); ++k) {
+                        weights[k]->values[termIndices[k]] = valueColumns[k * block + j];
+                    }
+                    activateRuleBlocks(context);
+                    defuzzify(context);
+                    for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+                        outputs[i * rows + row] = context.getOutputValue(i);
+                    }
+                }
+            }
+        } catch (...) {
+            for (std::size_t k = 0; k < terms.size(); ++k) {
+                weights[k]->values[termIndices[k]] = fl::nan;
+            }
+            throw;
+        }
+        for (std::size_t k = 0; k < terms.size(); ++k) {
+            weights[k]->values[termIndices[k]] = fl::nan;
+        }
+
+        for (std::size_t i = 0; i < _inputVariables.size(); ++i) {
+            _inputVariables.at(i)->setInputValue(context.getInputValue(i));
+        }
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            OutputVariable* outputVariable = _outputVariables.at(i);
+            outputVariable->setPreviousOutputValue(context.getPreviousOutputValue(i));
+            outputVariable->setOutputValue(context.getOutputValue(i));
+        }
+    }
+
+    void Engine::process(Context& context) const {
+        activate(context);
+        defuzzify(context);
+    }
+
+    void Engine::activate(Context& context) const {
+        if (not context.isLoaded(this)) {
+            throw fl::Exception("[engine error] context is not loaded for engine <" + _name + ">", FL_AT);
+        }
+        context.clearMemberships();
+        activateRuleBlocks(context);
+    }
+
+    void Engine::activateRuleBlocks(Context& context) const {
+        for (int i = 0; i < context.numberOfFuzzyOutputs(); ++i) {
+            context.fuzzyOutput(i)->clear();
+        }
+
+        for (std::size_t i = 0; i < _ruleblocks.size(); ++i) {
+            RuleBlock* ruleBlock = _ruleblocks.at(i);
+            if (ruleBlock->isEnabled()) {
+                ruleBlock->activate(context);
+            }
+        }
+    }
+
+    void Engine::defuzzify(Context& context) const {
+        if (not context.isLoaded(this)) {
+            throw fl::Exception("[engine error] context is not loaded for engine <" + _name + ">", FL_AT);
+        }
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            _outputVariables.at(i)->defuzzify(context, i);
+        }
+    }
+
+    Context& Engine::sharedContext() {
+        if (not (_context.get() and _context->isLoaded(this))) {
+            compile();
+            _context.reset(new Context);
+            _context->load(this, true);
+        }
+        for (std::size_t i = 0; i < _inputVariables.size(); ++i) {
+            _context->setInputValue(i, _inputVariables.at(i)->getInputValue());
+        }
+        for (std::size_t i = 0; i < _outputVariables.size(); ++i) {
+            OutputVariable* outputVariable = _outputVariables.at(i);
+            _context->setOutputValue(i, outputVariable->getOutputValue());
+            _context->setPreviousOutputValue(i, outputVariable->getPreviousOutputValue());
+        }
+        return *_context;
+    }
+
     void Engine::setName(const std::string& name) {
         this->_name = name;
     }
@@ -482,15 +684,18 @@ namespace fl {
 
     void Engine::addInputVariable(InputVariable* inputVariable) {
         this->_inputVariables.push_back(inputVariable);
+        this->_revision = nextRevision();
     }
 
     InputVariable* Engine::setInputVariable(InputVariable* inputVariable, int index) {
         InputVariable* result = this->_inputVariables.at(index);
+        this->_revision = nextRevision();
         this->_inputVariables.at(index) = inputVariable;
         return result;
     }
 
     void Engine::insertInputVariable(InputVariable* inputVariable, int index) {
+        this->_revision = nextRevision();
         this->_inputVariables.insert(this->_inputVariables.begin() + index,
                 inputVariable);
     }
@@ -516,6 +721,7 @@ namespace fl {
     }
 
     InputVariable* Engine::removeInputVariable(int index) {
+        this->_revision = nextRevision();
         InputVariable* result = this->_inputVariables.at(index);
         this->_inputVariables.erase(this->_inputVariables.begin() + index);
         return result;
@@ -526,6 +732,7 @@ namespace fl {
             if (_inputVariables.at(i)->getName() == name) {
                 InputVariable* result = this->_inputVariables.at(i);
                 this->_inputVariables.erase(this->_inputVariables.begin() + i);
+                this->_revision = nextRevision();
                 return result;
             }
         }
@@ -541,6 +748,7 @@ namespace fl {
     }
 
     void Engine::setInputVariables(const std::vector<InputVariable*>& inputVariables) {
+        this->_revision = nextRevision();
         this->_inputVariables = inputVariables;
     }
 
@@ -558,15 +766,18 @@ namespace fl {
 
     void Engine::addOutputVariable(OutputVariable* outputVariable) {
         this->_outputVariables.push_back(outputVariable);
+        this->_revision = nextRevision();
     }
 
     OutputVariable* Engine::setOutputVariable(OutputVariable* outputVariable, int index) {
         OutputVariable* result = this->_outputVariables.at(index);
+        this->_revision = nextRevision();
         this->_outputVariables.at(index) = outputVariable;
         return result;
     }
 
     void Engine::insertOutputVariable(OutputVariable* outputVariable, int index) {
+        this->_revision = nextRevision();
         this->_outputVariables.insert(this->_outputVariables.begin() + index,
                 outputVariable);
     }
@@ -592,6 +803,7 @@ namespace fl {
     }
 
     OutputVariable* Engine::removeOutputVariable(int index) {
+        this->_revision = nextRevision();
         OutputVariable* result = this->_outputVariables.at(index);
         this->_outputVariables.erase(this->_outputVariables.begin() + index);
         return result;
@@ -602,6 +814,7 @@ namespace fl {
             if (_outputVariables.at(i)->getName() == name) {
                 OutputVariable* result = this->_outputVariables.at(i);
                 this->_outputVariables.erase(this->_outputVariables.begin() + i);
+                this->_revision = nextRevision();
                 return result;
             }
         }
@@ -617,6 +830,7 @@ namespace fl {
     }
 
     void Engine::setOutputVariables(const std::vector<OutputVariable*>& outputVariables) {
+        this->_revision = nextRevision();
         this->_outputVariables = outputVariables;
     }
 
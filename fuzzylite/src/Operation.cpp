@@ -33,6 +33,7 @@
 #include <iomanip>
 #include <cstdarg>
 #include <cctype>
+#include <cstdlib>
 
 namespace fl {
 
@@ -367,6 +368,28 @@ namespace fl {
         return alternative;
     }
 
+    scalar Operation::parseScalar(const char* begin, const char* end) {
+#ifndef FL_USE_FLOAT
+        char buffer[64];
+        const std::size_t length = end - begin;
+        bool numeric = length > 0 and length < sizeof(buffer);
+        for (const char* it = begin; numeric and it != end; ++it) {
+            numeric = (*it >= '0' and *it <= '9') or *it == '.'
+                    or *it == '-' or *it == '+' or *it == 'e' or *it == 'E';
+        }
+        if (numeric) {
+            std::copy(begin, end, buffer);
+            buffer[length] = '\0';
+            char* parsed;
+            scalar result = std::strtod(buffer, &parsed);
+            //overflows fail, as in the extraction from a stream
+            if (parsed == buffer + length and std::fabs(result) != fl::inf) return result;
+        }
+#endif
+        //infinities, nan, floats and errors
+        return toScalar(std::string(begin, end));
+    }
+
     bool Operation::isNumeric(const std::string& x) {
         try {
             fl::Op::toScalar(x);
@@ -391,7 +414,70 @@ namespace fl {
         return ss.str();
     }
     template FL_API std::string Operation::str(int x, int precision);
-    template FL_API std::string Operation::str(scalar x, int precision);
+
+    template <> FL_API std::string Operation::str(scalar x, int decimals) {
+        std::string result;
+        str(x, decimals, result);
+        return result;
+    }
+
+    void Operation::str(scalar x, int decimals, std::string& text) {
+        if (fl::Op::isNaN(x)) {
+            text += "nan";
+            return;
+        }
+        if (fl::Op::isInf(x)) {
+            text += (fl::Op::isLt(x, 0.0) ? "-inf" : "inf");
+            return;
+        }
+        if (fl::Op::isEq(x, 0.0)) x = 0.0;
+
+        /*
+         * Rounds |x| * 10^decimals to the nearest integer, whose digits are
+         * those of the fixed notation. The product is rounded with a relative
+         * error of at most 2^-53, which can only change the result if it is
+         * that close to a midpoint between integers, in which case (and for
+         * large values) the stream rounds the exact value of x instead.
+         */
+        static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+            1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17};
+        if (decimals >= 0 and decimals <= 17) {
+            const double scaled = std::fabs(double(x)) * powers[decimals];
+            if (scaled < 4503599627370496.0) { //2^52, such that the digits are integers
+                const double integral = std::floor(scaled);
+                const double fraction = scaled - integral;
+                if (std::fabs(fraction - 0.5) > scaled * 2.220446049250313e-16) {
+                    //integers below 2^53 are exact, and so are their digits
+                    double digits = integral + (fraction > 0.5 ? 1.0 : 0.0);
+                    char buffer[40];
+                    char* end = buffer + sizeof (buffer);
+                    char* it = end;
+                    int position = 0;
+                    do {
+                        if (position == decimals and decimals > 0) *--it = '.';
+                        double quotient = std::floor(digits / 10.0);
+                        double digit = digits - 10.0 * quotient;
+                        if (digit < 0.0) {
+                            quotient -= 1.0;
+                            digit += 10.0;
+                        } else if (digit >= 10.0) {
+                            quotient += 1.0;
+                            digit -= 10.0;
+                        }
+                        *--it = char('0' + int(digit));
+                        digits = quotient;
+                        ++position;
+                    } while (position <= decimals or digits > 0.0);
+                    if (x < 0.0) *--it = '-';
+                    text.append(it, end);
+                    return;
+                }
+            }
+        }
+        std::ostringstream ss;
+        ss << std::setprecision(decimals) << std::fixed << x;
+        text += ss.str();
+    }
 
     template <> FL_API std::string Operation::str(const std::string& x, int precision) {
         (void) precision;
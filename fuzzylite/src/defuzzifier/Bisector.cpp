@@ -45,6 +45,31 @@ namespace fl {
         if (not fl::Op::isFinite(minimum + maximum)) {
             return fl::nan;
         }
+        std::vector<std::pair<scalar, scalar> > vertices;
+        if ((_analytical and piecewiseLinear(term, minimum, maximum, vertices))
+                or adaptiveSampling(term, minimum, maximum, vertices)) {
+            scalar area = 0;
+            for (std::size_t i = 1; i < vertices.size(); ++i) {
+                area += 0.5 * (vertices.at(i).first - vertices.at(i - 1).first)
+                        * (vertices.at(i - 1).second + vertices.at(i).second);
+            }
+            if (not (area > 0.0)) return fl::nan;
+            scalar remaining = 0.5 * area;
+            for (std::size_t i = 1; i < vertices.size(); ++i) {
+                scalar x0 = vertices.at(i - 1).first, y0 = vertices.at(i - 1).second;
+                scalar x1 = vertices.at(i).first, y1 = vertices.at(i).second;
+                scalar segment = 0.5 * (x1 - x0) * (y0 + y1);
+                if (segment < remaining) {
+                    remaining -= segment;
+                    continue;
+                }
+                //solves y0 * t + slope * t^2 / 2 = remaining for t in [0, x1 - x0]
+                scalar slope = (y1 - y0) / (x1 - x0);
+                scalar root = std::sqrt(std::max(scalar(0.0), y0 * y0 + 2 * slope * remaining));
+                return x0 + Op::min(x1 - x0, 2 * remaining / (y0 + root));
+            }
+            return vertices.back().first;
+        }
         if (maximum - minimum > _resolution) {
             FL_DBG("[accuracy warning] the resolution <" << _resolution << "> "
                     "is smaller than the range <" << minimum << ", " << maximum << ">. In order to "
@@ -52,8 +77,17 @@ namespace fl {
         }
         scalar dx = (maximum - minimum) / _resolution;
 
-        int counter = _resolution;
-        int left = 0, right = 0;
+        //samples only the hull of the supports of the terms, elsewhere the membership is zero
+        scalar start, end;
+        term->support(start, end);
+        start = Op::max(start, minimum);
+        end = Op::min(end, maximum);
+        int left = 0, right = 0, counter = 0;
+        if (start <= end) {
+            left = std::max(0, int(std::floor((start - minimum) / dx - 0.5)));
+            right = std::max(0, _resolution - 1 - int(std::ceil((end - minimum) / dx - 0.5)));
+            counter = _resolution - left - right;
+        }
         scalar leftArea = 0, rightArea = 0;
         scalar xLeft = minimum, xRight = maximum;
         while (counter-- > 0) {
@@ -73,6 +107,34 @@ namespace fl {
         return bisector;
     }
 
+    scalar Bisector::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context&) const {
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return fl::nan;
+        }
+        int resolution = samples.size();
+        scalar dx = (maximum - minimum) / resolution;
+
+        int counter = resolution;
+        int left = 0, right = 0;
+        scalar leftArea = 0, rightArea = 0;
+        scalar xLeft = minimum, xRight = maximum;
+        while (counter-- > 0) {
+            if (fl::Op::isLE(leftArea, rightArea)) {
+                xLeft = minimum + (left + 0.5) * dx;
+                leftArea += samples[left];
+                left++;
+            } else {
+                xRight = maximum - (right + 0.5) * dx;
+                rightArea += samples[resolution - 1 - right];
+                right++;
+            }
+        }
+
+        //Inverse weighted average to compensate
+        return (leftArea * xRight + rightArea * xLeft) / (leftArea + rightArea);
+    }
+
     Bisector* Bisector::clone() const {
         return new Bisector(*this);
     }
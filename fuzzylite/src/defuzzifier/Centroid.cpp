@@ -46,6 +46,18 @@ namespace fl {
         if (not fl::Op::isFinite(minimum + maximum)) {
             return fl::nan;
         }
+        std::vector<std::pair<scalar, scalar> > vertices;
+        if ((_analytical and piecewiseLinear(term, minimum, maximum, vertices))
+                or adaptiveSampling(term, minimum, maximum, vertices)) {
+            scalar area = 0, moment = 0;
+            for (std::size_t i = 1; i < vertices.size(); ++i) {
+                scalar x0 = vertices.at(i - 1).first, y0 = vertices.at(i - 1).second;
+                scalar x1 = vertices.at(i).first, y1 = vertices.at(i).second;
+                area += 0.5 * (x1 - x0) * (y0 + y1);
+                moment += (x1 - x0) * (x0 * (2 * y0 + y1) + x1 * (y0 + 2 * y1)) / 6.0;
+            }
+            return moment / area;
+        }
         if (maximum - minimum > _resolution) {
             FL_DBG("[accuracy warning] the resolution <" << _resolution << "> "
                     "is smaller than the range <" << minimum << ", " << maximum << ">. In order to "
@@ -54,13 +66,21 @@ namespace fl {
         scalar dx = (maximum - minimum) / _resolution;
         scalar x, y;
         scalar area = 0, xcentroid = 0, ycentroid = 0;
-        for (int i = 0; i < _resolution; ++i) {
-            x = minimum + (i + 0.5) * dx;
-            y = term->membership(x);
-
-            xcentroid += y * x;
-            ycentroid += y * y;
-            area += y;
+        //samples only the supports of the terms, elsewhere the membership is zero
+        scalar start, end;
+        int i = 0;
+        while (i < _resolution and nextSupport(term, minimum + (i + 0.5) * dx, maximum, start, end)) {
+            i = std::max(i, int(std::floor((start - minimum) / dx - 0.5)));
+            int last = std::max(i, std::min(_resolution - 1,
+                    int(std::ceil((end - minimum) / dx - 0.5))));
+            for (; i <= last; ++i) {
+                x = minimum + (i + 0.5) * dx;
+                y = term->membership(x);
+
+                xcentroid += y * x;
+                ycentroid += y * y;
+                area += y;
+            }
         }
         xcentroid /= area;
         ycentroid /= 2 * area;
@@ -68,6 +88,24 @@ namespace fl {
         return xcentroid;
     }
 
+    scalar Centroid::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context&) const {
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return fl::nan;
+        }
+        scalar dx = (maximum - minimum) / samples.size();
+        scalar x, y;
+        scalar area = 0, xcentroid = 0;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            x = minimum + (i + 0.5) * dx;
+            y = samples[i];
+
+            xcentroid += y * x;
+            area += y;
+        }
+        return xcentroid / area;
+    }
+
     Centroid* Centroid::clone() const {
         return new Centroid(*this);
     }
@@ -23,11 +23,27 @@
  */
 
 #include "fl/defuzzifier/IntegralDefuzzifier.h"
+#include "fl/Context.h"
+
+#include "fl/norm/SNorm.h"
+#include "fl/norm/TNorm.h"
+#include "fl/term/Accumulated.h"
+#include "fl/term/Activated.h"
+#include "fl/term/Discrete.h"
+#include "fl/term/Ramp.h"
+#include "fl/term/Rectangle.h"
+#include "fl/term/Trapezoid.h"
+#include "fl/term/Triangle.h"
 
 namespace fl {
 
     int IntegralDefuzzifier::_defaultResolution = 200;
 
+    IntegralDefuzzifier::Sweep::Sweep()
+    : centroid(fl::nan), bisector(fl::nan), smallestOfMaximum(fl::nan),
+    meanOfMaximum(fl::nan), largestOfMaximum(fl::nan) {
+    }
+
     void IntegralDefuzzifier::setDefaultResolution(int defaultResolution) {
         _defaultResolution = defaultResolution;
     }
@@ -37,12 +53,89 @@ namespace fl {
     }
 
     IntegralDefuzzifier::IntegralDefuzzifier(int resolution)
-    : Defuzzifier(), _resolution(resolution) {
+    : Defuzzifier(), _resolution(resolution), _analytical(false), _tolerance(0.0) {
     }
 
     IntegralDefuzzifier::~IntegralDefuzzifier() {
     }
 
+    scalar IntegralDefuzzifier::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context& context) const {
+        //Defuzzifiers sampling the same points obtain the samples from their interpolation
+        Discrete& discrete = context.discrete();
+        std::vector<Discrete::Pair>& xy = discrete.xy();
+        xy.resize(samples.size());
+        scalar dx = (maximum - minimum) / samples.size();
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            xy[i] = Discrete::Pair(minimum + (i + 0.5) * dx, samples[i]);
+        }
+        discrete.updateIndex();
+        return defuzzify(&discrete, minimum, maximum);
+    }
+
+    IntegralDefuzzifier::Sweep IntegralDefuzzifier::sweep(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum) {
+        Sweep result;
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return result;
+        }
+        //Same computations as in Centroid, SmallestOfMaximum, MeanOfMaximum and
+        //LargestOfMaximum::defuzzifySamples, but in one pass
+        int resolution = samples.size();
+        scalar dx = (maximum - minimum) / resolution;
+        scalar x, y;
+        scalar area = 0, xcentroid = 0;
+        scalar ymax = -1.0, xsmallest = minimum, xplateau = maximum;
+        bool samePlateau = false;
+        scalar ylargest = -1.0, xlargest = maximum;
+        for (int i = 0; i < resolution; ++i) {
+            x = minimum + (i + 0.5) * dx;
+            y = samples[i];
+
+            xcentroid += y * x;
+            area += y;
+
+            if (Op::isGt(y, ymax)) {
+                ymax = y;
+                xsmallest = x;
+                xplateau = x;
+                samePlateau = true;
+            } else if (Op::isEq(y, ymax) and samePlateau) {
+                xplateau = x;
+            } else if (Op::isLt(y, ymax)) {
+                samePlateau = false;
+            }
+
+            if (Op::isGE(y, ylargest)) {
+                ylargest = y;
+                xlargest = x;
+            }
+        }
+        result.centroid = xcentroid / area;
+        result.smallestOfMaximum = xsmallest;
+        result.meanOfMaximum = (xplateau + xsmallest) / 2.0;
+        result.largestOfMaximum = xlargest;
+
+        //Same as Bisector::defuzzifySamples
+        int counter = resolution;
+        int left = 0, right = 0;
+        scalar leftArea = 0, rightArea = 0;
+        scalar xLeft = minimum, xRight = maximum;
+        while (counter-- > 0) {
+            if (fl::Op::isLE(leftArea, rightArea)) {
+                xLeft = minimum + (left + 0.5) * dx;
+                leftArea += samples[left];
+                left++;
+            } else {
+                xRight = maximum - (right + 0.5) * dx;
+                rightArea += samples[resolution - 1 - right];
+                right++;
+            }
+        }
+        result.bisector = (leftArea * xRight + rightArea * xLeft) / (leftArea + rightArea);
+        return result;
+    }
+
     void IntegralDefuzzifier::setResolution(int resolution) {
         this->_resolution = resolution;
     }
@@ -50,4 +143,284 @@ namespace fl {
     int IntegralDefuzzifier::getResolution() const {
         return this->_resolution;
     }
+
+    void IntegralDefuzzifier::setAnalytical(bool analytical) {
+        this->_analytical = analytical;
+    }
+
+    bool IntegralDefuzzifier::isAnalytical() const {
+        return this->_analytical;
+    }
+
+    void IntegralDefuzzifier::setTolerance(scalar tolerance) {
+        this->_tolerance = tolerance;
+    }
+
+    scalar IntegralDefuzzifier::getTolerance() const {
+        return this->_tolerance;
+    }
+
+    bool IntegralDefuzzifier::nextSupport(const Term* term, scalar from, scalar maximum,
+            scalar& start, scalar& end) const {
+        //the union of the supports of the activated terms, one interval at a time
+        const Accumulated* accumulated = dynamic_cast<const Accumulated*> (term);
+        int terms = accumulated ? accumulated->numberOfTerms() : 1;
+        scalar low, high;
+        start = fl::inf;
+        for (int i = 0; i < terms; ++i) {
+            if (accumulated) accumulated->getTerm(i)->support(low, high);
+            else term->support(low, high);
+            if (fl::Op::isNaN(low)) low = -fl::inf;
+            if (fl::Op::isNaN(high)) high = fl::inf;
+            if (low <= high and high > from) start = Op::min(start, Op::max(low, from));
+        }
+        if (not (start <= maximum)) return false;
+
+        end = start;
+        bool extended = true;
+        while (extended) {
+            extended = false;
+            for (int i = 0; i < terms; ++i) {
+                if (accumulated) accumulated->getTerm(i)->support(low, high);
+                else term->support(low, high);
+                if (fl::Op::isNaN(low)) low = -fl::inf;
+                if (fl::Op::isNaN(high)) high = fl::inf;
+                if (low <= end and high > end) {
+                    end = high;
+                    extended = true;
+                }
+            }
+        }
+        end = Op::min(end, maximum);
+        return true;
+    }
+
+    bool IntegralDefuzzifier::breakpoints(const Term* term, scalar degree,
+            std::vector<scalar>& xs, scalar& low, scalar& high) const {
+        if (not term or not (term->getHeight() >= 0.0)) return false;
+        //fraction of the height at which the activation degree clips the term
+        scalar clip = degree / term->getHeight();
+        bool clipped = clip > 0.0 and clip < 1.0;
+
+        if (const Triangle* triangle = dynamic_cast<const Triangle*> (term)) {
+            scalar a = triangle->getVertexA(), b = triangle->getVertexB(), c = triangle->getVertexC();
+            xs.push_back(a);
+            xs.push_back(b);
+            xs.push_back(c);
+            if (clipped) {
+                xs.push_back(a + clip * (b - a));
+                xs.push_back(c - clip * (c - b));
+            }
+            low = a;
+            high = c;
+            return true;
+        }
+        if (const Trapezoid* trapezoid = dynamic_cast<const Trapezoid*> (term)) {
+            scalar a = trapezoid->getVertexA(), b = trapezoid->getVertexB(),
+                    c = trapezoid->getVertexC(), d = trapezoid->getVertexD();
+            xs.push_back(a);
+            xs.push_back(b);
+            xs.push_back(c);
+            xs.push_back(d);
+            if (clipped) {
+                xs.push_back(a + clip * (b - a));
+                xs.push_back(d - clip * (d - c));
+            }
+            low = a;
+            high = d;
+            return true;
+        }
+        if (const Rectangle* rectangle = dynamic_cast<const Rectangle*> (term)) {
+            xs.push_back(rectangle->getStart());
+            xs.push_back(rectangle->getEnd());
+            low = rectangle->getStart();
+            high = rectangle->getEnd();
+            return true;
+        }
+        if (const Ramp* ramp = dynamic_cast<const Ramp*> (term)) {
+            scalar start = ramp->getStart(), end = ramp->getEnd();
+            xs.push_back(start);
+            xs.push_back(end);
+            if (clipped) xs.push_back(start + clip * (end - start));
+            low = -fl::inf;
+            high = fl::inf;
+            return true;
+        }
+        return false;
+    }
+
+    bool IntegralDefuzzifier::piecewiseLinear(const Term* term, scalar minimum, scalar maximum,
+            std::vector<std::pair<scalar, scalar> >& vertices) const {
+        std::vector<const Term*> pieces;
+        std::vector<scalar> lows, highs;
+        std::vector<scalar> xs;
+        scalar low, high;
+
+        if (const Accumulated* accumulated = dynamic_cast<const Accumulated*> (term)) {
+            const SNorm* accumulation = accumulated->getAccumulation();
+            if (not (accumulated->isEmpty() or
+                    (accumulation and accumulation->kernel() == Norm::MaximumKernel))) {
+                return false;
+            }
+            for (int i = 0; i < accumulated->numberOfTerms(); ++i) {
+                const Activated* activated = accumulated->getTerm(i);
+                scalar degree = activated->getDegree();
+                const TNorm* activation = activated->getActivation();
+                if (not (activation and activation->kernel() == Norm::MinimumKernel
+                        and fl::Op::isFinite(degree))) {
+                    return false;
+                }
+                if (not breakpoints(activated->getTerm(), degree, xs, low, high)) {
+                    return false;
+                }
+                if (degree > 0.0) {
+                    pieces.push_back(activated);
+                    lows.push_back(low);
+                    highs.push_back(high);
+                }
+            }
+        } else {
+            if (not breakpoints(term, fl::inf, xs, low, high)) return false;
+            pieces.push_back(term);
+            lows.push_back(low);
+            highs.push_back(high);
+        }
+
+        //Every piece is linear between consecutive breakpoints within the range
+        std::vector<scalar> grid;
+        grid.reserve(xs.size() + 2);
+        grid.push_back(minimum);
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            if (xs.at(i) > minimum and xs.at(i) < maximum) grid.push_back(xs.at(i));
+        }
+        grid.push_back(maximum);
+        std::sort(grid.begin(), grid.end());
+        grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+
+        std::vector<std::size_t> active;
+        std::vector<scalar> start, slope;
+        vertices.clear();
+        vertices.reserve(2 * grid.size());
+        for (std::size_t g = 0; g + 1 < grid.size(); ++g) {
+            scalar a = grid.at(g), b = grid.at(g + 1);
+            //pieces are sampled inside the interval and extrapolated to its ends,
+            //which takes the one-sided limits at discontinuities
+            scalar quarter = 0.25 * (b - a);
+            active.clear();
+            start.clear();
+            slope.clear();
+            for (std::size_t p = 0; p < pieces.size(); ++p) {
+                if (highs.at(p) < a or lows.at(p) > b) continue;
+                scalar y1 = pieces.at(p)->membership(a + quarter);
+                scalar y3 = pieces.at(p)->membership(b - quarter);
+                active.push_back(p);
+                start.push_back(1.5 * y1 - 0.5 * y3);
+                slope.push_back((y3 - y1) / (2.0 * quarter));
+            }
+
+            //upper envelope of the active lines and the zero baseline
+            std::size_t top = active.size(); //index of the baseline
+            scalar topStart = 0.0, topSlope = 0.0;
+            for (std::size_t i = 0; i < active.size(); ++i) {
+                if (start.at(i) > topStart or
+                        (start.at(i) == topStart and slope.at(i) > topSlope)) {
+                    top = i;
+                    topStart = start.at(i);
+                    topSlope = slope.at(i);
+                }
+            }
+            scalar x = a;
+            vertices.push_back(std::make_pair(a, topStart));
+            while (true) {
+                std::size_t next = top;
+                scalar crossing = b;
+                scalar nextStart = topStart, nextSlope = topSlope;
+                for (std::size_t i = 0; i <= active.size(); ++i) {
+                    if (i == top) continue;
+                    scalar iStart = i < active.size() ? start.at(i) : 0.0;
+                    scalar iSlope = i < active.size() ? slope.at(i) : 0.0;
+                    if (not (iSlope > topSlope)) continue;
+                    scalar xi = a + (topStart - iStart) / (iSlope - topSlope);
+                    if (xi >= x and (xi < crossing or (xi == crossing and next != top
+                            and iSlope > nextSlope))) {
+                        next = i;
+                        crossing = xi;
+                        nextStart = iStart;
+                        nextSlope = iSlope;
+                    }
+                }
+                if (next == top) break;
+                x = crossing;
+                vertices.push_back(std::make_pair(x, topStart + topSlope * (x - a)));
+                top = next;
+                topStart = nextStart;
+                topSlope = nextSlope;
+            }
+            vertices.push_back(std::make_pair(b, topStart + topSlope * (b - a)));
+        }
+        return true;
+    }
+
+    bool IntegralDefuzzifier::adaptiveSampling(const Term* term, scalar minimum, scalar maximum,
+            std::vector<std::pair<scalar, scalar> >& vertices) const {
+        if (not (_tolerance > 0.0 and _resolution > 0)) return false;
+        //a coarse grid on each support to start with, so that narrow terms are not skipped
+        const int panels = std::min(16, _resolution);
+        scalar width = (maximum - minimum) / _resolution;
+        scalar x[33], y[33];
+
+        vertices.clear();
+        scalar start, end, from = minimum;
+        bool first = true;
+        //the supports end past the previous ones while below the maximum, which clips them
+        while (from < maximum and nextSupport(term, from, maximum, start, end)) {
+            from = end;
+            if (not (end > start)) continue;
+            if (not first) {
+                //the membership is zero between supports
+                vertices.push_back(std::make_pair(vertices.back().first, scalar(0.0)));
+                vertices.push_back(std::make_pair(start, scalar(0.0)));
+            }
+            first = false;
+
+            scalar dx = (end - start) / (2 * panels);
+            scalar height = 0.0;
+            for (int i = 0; i <= 2 * panels; ++i) {
+                x[i] = (i == 2 * panels) ? end : start + i * dx;
+            }
+            term->membership(x, y, 2 * panels + 1);
+            for (int i = 0; i <= 2 * panels; ++i) {
+                height = Op::max(height, std::abs(y[i]));
+            }
+            //the tolerance is relative to the height of the curve
+            scalar tolerance = _tolerance * (height > 0.0 ? height : scalar(1.0));
+
+            vertices.push_back(std::make_pair(x[0], y[0]));
+            for (int i = 0; i < 2 * panels; i += 2) {
+                refine(term, x[i], y[i], x[i + 1], y[i + 1], x[i + 2], y[i + 2],
+                        tolerance, width, vertices);
+            }
+        }
+        return true;
+    }
+
+    void IntegralDefuzzifier::refine(const Term* term, scalar a, scalar fa,
+            scalar m, scalar fm, scalar b, scalar fb,
+            scalar tolerance, scalar width, std::vector<std::pair<scalar, scalar> >& vertices) const {
+        scalar q1 = 0.5 * (a + m), fq1 = term->membership(q1);
+        scalar q3 = 0.5 * (m + b), fq3 = term->membership(q3);
+        //differences between the trapezoidal rule on each interval and on its halves,
+        //checked on both halves too so that collinear samples do not hide kinks
+        scalar error = Op::max(std::abs(fa - 2 * fm + fb),
+                Op::max(std::abs(fa - 2 * fq1 + fm), std::abs(fm - 2 * fq3 + fb)));
+        if ((b - a) > 4 * width and 0.25 * error > 3 * tolerance) {
+            refine(term, a, fa, q1, fq1, m, fm, tolerance, width, vertices);
+            refine(term, m, fm, q3, fq3, b, fb, tolerance, width, vertices);
+        } else {
+            vertices.push_back(std::make_pair(q1, fq1));
+            vertices.push_back(std::make_pair(m, fm));
+            vertices.push_back(std::make_pair(q3, fq3));
+            vertices.push_back(std::make_pair(b, fb));
+        }
+    }
 }
@@ -64,6 +64,22 @@ namespace fl {
         return xlargest;
     }
 
+    scalar LargestOfMaximum::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context&) const {
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return fl::nan;
+        }
+        scalar dx = (maximum - minimum) / samples.size();
+        scalar ymax = -1.0, xlargest = maximum;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            if (Op::isGE(samples[i], ymax)) {
+                ymax = samples[i];
+                xlargest = minimum + (i + 0.5) * dx;
+            }
+        }
+        return xlargest;
+    }
+
     LargestOfMaximum* LargestOfMaximum::clone() const {
         return new LargestOfMaximum(*this);
     }
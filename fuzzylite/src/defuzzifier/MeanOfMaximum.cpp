@@ -77,6 +77,38 @@ namespace fl {
         return (xlargest + xsmallest) / 2.0;
     }
 
+    scalar MeanOfMaximum::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context&) const {
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return fl::nan;
+        }
+        scalar dx = (maximum - minimum) / samples.size();
+        scalar x, y;
+        scalar ymax = -1.0;
+        scalar xsmallest = minimum;
+        scalar xlargest = maximum;
+        bool samePlateau = false;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            x = minimum + (i + 0.5) * dx;
+            y = samples[i];
+
+            if (Op::isGt(y, ymax)) {
+                ymax = y;
+
+                xsmallest = x;
+                xlargest = x;
+
+                samePlateau = true;
+            } else if (Op::isEq(y, ymax) and samePlateau) {
+                xlargest = x;
+            } else if (Op::isLt(y, ymax)) {
+                samePlateau = false;
+            }
+        }
+
+        return (xlargest + xsmallest) / 2.0;
+    }
+
     MeanOfMaximum* MeanOfMaximum::clone() const {
         return new MeanOfMaximum(*this);
     }
@@ -65,6 +65,22 @@ namespace fl {
         return xsmallest;
     }
 
+    scalar SmallestOfMaximum::defuzzifySamples(const std::vector<scalar>& samples,
+            scalar minimum, scalar maximum, Context&) const {
+        if (samples.empty() or not fl::Op::isFinite(minimum + maximum)) {
+            return fl::nan;
+        }
+        scalar dx = (maximum - minimum) / samples.size();
+        scalar ymax = -1.0, xsmallest = minimum;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            if (Op::isGt(samples[i], ymax)) {
+                xsmallest = minimum + (i + 0.5) * dx;
+                ymax = samples[i];
+            }
+        }
+        return xsmallest;
+    }
+
     SmallestOfMaximum* SmallestOfMaximum::clone() const {
         return new SmallestOfMaximum(*this);
     }
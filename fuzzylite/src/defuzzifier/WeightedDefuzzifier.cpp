@@ -24,15 +24,12 @@
 
 #include "fl/defuzzifier/WeightedDefuzzifier.h"
 
+#include "fl/norm/SNorm.h"
+#include "fl/term/Accumulated.h"
 #include "fl/term/Activated.h"
-#include "fl/term/Concave.h"
-#include "fl/term/Constant.h"
-#include "fl/term/Function.h"
-#include "fl/term/Linear.h"
-#include "fl/term/Ramp.h"
-#include "fl/term/Sigmoid.h"
-#include "fl/term/SShape.h"
-#include "fl/term/ZShape.h"
+
+#include <algorithm>
+#include <map>
 
 namespace fl {
 
@@ -77,20 +74,11 @@ namespace fl {
     }
 
     WeightedDefuzzifier::Type WeightedDefuzzifier::inferType(const Term* term) const {
-        if (dynamic_cast<const Constant*> (term)
-                or dynamic_cast<const Linear*> (term)
-                or dynamic_cast<const Function*> (term)) {
-            return TakagiSugeno;
-        }
-        return Tsukamoto;
+        return term->isTakagiSugeno() ? TakagiSugeno : Tsukamoto;
     }
 
     bool WeightedDefuzzifier::isMonotonic(const Term* term) const {
-        return (dynamic_cast<const Concave*> (term)) or
-                (dynamic_cast<const Ramp*> (term)) or
-                (dynamic_cast<const Sigmoid*> (term)) or
-                (dynamic_cast<const SShape*> (term)) or
-                (dynamic_cast<const ZShape*> (term));
+        return term->isMonotonic();
     }
 
     /**
@@ -100,62 +88,9 @@ namespace fl {
     scalar WeightedDefuzzifier::tsukamoto(const Term* monotonic, scalar activationDegree,
             scalar minimum, scalar maximum) const {
         scalar w = activationDegree;
-        scalar z = fl::nan; //result;
-        bool isTsukamoto = true;
-        if (const Ramp* ramp = dynamic_cast<const Ramp*> (monotonic)) {
-            z = Op::scale(w, 0, 1, ramp->getStart(), ramp->getEnd());
-
-        } else if (const Sigmoid* sigmoid = dynamic_cast<const Sigmoid*> (monotonic)) {
-            if (Op::isEq(w, 1.0)) {
-                if (Op::isGE(sigmoid->getSlope(), 0.0)) {
-                    z = maximum;
-                } else {
-                    z = minimum;
-                }
-
-            } else if (Op::isEq(w, 0.0)) {
-                if (Op::isGE(sigmoid->getSlope(), 0.0)) {
-                    z = minimum;
-                } else {
-                    z = maximum;
-                }
-            } else {
-                scalar a = sigmoid->getSlope();
-                scalar b = sigmoid->getInflection();
-                z = b + (std::log(1.0 / w - 1.0) / -a);
-            }
-
-        } else if (const SShape* sshape = dynamic_cast<const SShape*> (monotonic)) {
-            scalar difference = sshape->getEnd() - sshape->getStart();
-            scalar a = sshape->getStart() + std::sqrt(w * difference * difference / 2.0);
-            scalar b = sshape->getEnd() + std::sqrt(difference * difference * (w - 1.0) / -2.0);
-            if (std::fabs(w - monotonic->membership(a)) <
-                    std::fabs(w - monotonic->membership(b))) {
-                z = a;
-            } else {
-                z = b;
-            }
-
-        } else if (const ZShape* zshape = dynamic_cast<const ZShape*> (monotonic)) {
-            scalar difference = zshape->getEnd() - zshape->getStart();
-            scalar a = zshape->getStart() + std::sqrt(difference * difference * (w - 1.0) / -2.0);
-            scalar b = zshape->getEnd() + std::sqrt(w * difference * difference / 2.0);
-            if (std::fabs(w - monotonic->membership(a)) <
-                    std::fabs(w - monotonic->membership(b))) {
-                z = a;
-            } else {
-                z = b;
-            }
-
-        } else if (const Concave* concave = dynamic_cast<const Concave*> (monotonic)) {
-            scalar i = concave->getInflection();
-            scalar e = concave->getEnd();
-            z = (i - e) / concave->membership(w) + 2 * e - i;
-        } else {
-            isTsukamoto = false;
-        }
-
-        if (isTsukamoto) {
+        scalar z = monotonic->tsukamoto(w, minimum, maximum);
+        FL_DEBUG_BEGIN;
+        if (monotonic->isMonotonic()) {
             //Compare difference between estimated and true value
             scalar fz = monotonic->membership(z);
             if (not Op::isEq(w, fz, 1e-2)) {
@@ -167,12 +102,100 @@ namespace fl {
                         "f(z)=" << fz << " and "
                         "z=" << Op::str(z));
             }
-        } else {
-            // else fallback to the regular Takagi-Sugeno or inverse Tsukamoto (according to term)
-            z = monotonic->membership(w);
         }
+        FL_DEBUG_END;
         return z;
     }
 
+    int WeightedDefuzzifier::accumulate(const Accumulated* fuzzyOutput, Context::Weights& weights) const {
+        const std::vector<Activated*>& terms = fuzzyOutput->terms();
+        const int capacity = weights.degrees.size();
+        int size = 0;
+        for (std::size_t i = 0; i < terms.size(); ++i) {
+            int index = terms.at(i)->getTermIndex();
+            if (index < 0 or index >= capacity) return -1;
+            size = std::max(size, index + 1);
+        }
+        std::fill(weights.degrees.begin(), weights.degrees.begin() + size, scalar(0.0));
+        std::fill(weights.first.begin(), weights.first.begin() + size, -1);
+        const SNorm* accumulation = fuzzyOutput->getAccumulation();
+        for (std::size_t i = 0; i < terms.size(); ++i) {
+            const Activated* activated = terms.at(i);
+            int index = activated->getTermIndex();
+            if (weights.first[index] < 0) weights.first[index] = i;
+            weights.degrees[index] = accumulation
+                    ? accumulation->compute(weights.degrees[index], activated->getDegree())
+                    : weights.degrees[index] + activated->getDegree();
+        }
+        return size;
+    }
+
+    scalar WeightedDefuzzifier::value(const Activated* activated, scalar w, Type& type,
+            const Context::Weights* weights, scalar minimum, scalar maximum) const {
+        const Term* term = activated->getTerm();
+        const int index = activated->getTermIndex();
+        const bool resolved = weights and index >= 0 and index < int(weights->monotonic.size());
+        if (type == Automatic) {
+            if (resolved) type = weights->takagiSugeno[index] ? TakagiSugeno : Tsukamoto;
+            else type = inferType(term);
+        }
+        if (type == Tsukamoto and (resolved ? weights->monotonic[index] : isMonotonic(term))) {
+            return tsukamoto(term, w, minimum, maximum);
+        }
+        if (resolved and not Op::isNaN(weights->values[index])) return weights->values[index];
+        //term->membership(fl::nan) would ensure no Tsukamoto applies, but Inverse Tsukamoto with Functions would not work.
+        const Context* context = activated->getContext();
+        return context ? term->membership(w, *context) : term->membership(w);
+    }
+
+    void WeightedDefuzzifier::weightedSum(const Accumulated* fuzzyOutput, scalar minimum, scalar maximum,
+            scalar& sum, scalar& weights) const {
+        sum = 0.0;
+        weights = 0.0;
+        Type type = _type;
+        //The weights of the context are sized and resolved for the terms of the output variable when loaded
+        Context* context = fuzzyOutput->isEmpty() ? fl::null : fuzzyOutput->getTerm(0)->getContext();
+        Context::Weights* grouped = context ? context->weights(fuzzyOutput) : fl::null;
+        if (not fuzzyOutput->getAccumulation()) {
+            for (int i = 0; i < fuzzyOutput->numberOfTerms(); ++i) {
+                const Activated* activated = fuzzyOutput->getTerm(i);
+                scalar w = activated->getDegree();
+                scalar z = value(activated, w, type, grouped, minimum, maximum);
+                sum += w * z;
+                weights += w;
+            }
+            return;
+        }
+
+        int size = grouped ? accumulate(fuzzyOutput, *grouped) : -1;
+        if (size >= 0) {
+            for (int index = 0; index < size; ++index) {
+                if (grouped->first[index] < 0) continue;
+                const Activated* activated = fuzzyOutput->getTerm(grouped->first[index]);
+                scalar w = grouped->degrees[index];
+                scalar z = value(activated, w, type, grouped, minimum, maximum);
+                sum += w * z;
+                weights += w;
+            }
+            return;
+        }
+
+        //Groups by term the activated terms added without the index of their term
+        typedef std::map<const Term*, std::vector<const Activated*> > TermGroup;
+        TermGroup groups;
+        for (int i = 0; i < fuzzyOutput->numberOfTerms(); ++i) {
+            const Activated* activated = fuzzyOutput->getTerm(i);
+            groups[activated->getTerm()].push_back(activated);
+        }
+        for (TermGroup::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+            scalar w = 0.0;
+            for (std::size_t i = 0; i < it->second.size(); ++i) {
+                w = fuzzyOutput->getAccumulation()->compute(w, it->second.at(i)->getDegree());
+            }
+            scalar z = value(it->second.front(), w, type, grouped, minimum, maximum);
+            sum += w * z;
+            weights += w;
+        }
+    }
 
 }
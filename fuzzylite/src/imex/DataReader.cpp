@@ -0,0 +1,135 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "fl/imex/DataReader.h"
+
+#include "fl/Engine.h"
+#include "fl/Operation.h"
+#include "fl/variable/InputVariable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+
+namespace fl {
+
+    DataReader::DataReader(const Engine* engine, int maximum) : _engine(engine), _reader(fl::null),
+    _resolution(-1 + (int) std::max(1.0, std::pow(maximum, 1.0 / engine->numberOfInputVariables()))),
+    _sampleValues(engine->numberOfInputVariables(), 0),
+    _minSampleValues(engine->numberOfInputVariables(), 0),
+    _maxSampleValues(engine->numberOfInputVariables(), _resolution),
+    _overflow(false), _lineNumber(0), _binary(false), _singlePrecision(false),
+    _columns(0), _blockRows(0), _blockRow(0) {
+    }
+
+    DataReader::DataReader(const Engine* engine, std::istream& reader) : _engine(engine), _reader(&reader),
+    _resolution(0), _overflow(false), _lineNumber(0), _binary(false), _singlePrecision(false),
+    _columns(0), _blockRows(0), _blockRow(0) {
+        _binary = _flbExporter.isHeader(reader);
+        if (_binary) {
+            std::string engineName;
+            std::vector<std::string> inputNames, outputNames;
+            _flbExporter.readHeader(reader, engineName, inputNames, outputNames, _singlePrecision);
+            _inputColumns = _flbExporter.inputColumns(engine, inputNames);
+            _columns = inputNames.size() + outputNames.size();
+        }
+    }
+
+    DataReader::~DataReader() {
+    }
+
+    bool DataReader::readsLines() const {
+        return _reader and not _binary;
+    }
+
+    int DataReader::getLineNumber() const {
+        return this->_lineNumber;
+    }
+
+    bool DataReader::readLine(std::string& line) {
+        if (not readsLines()) {
+            throw fl::Exception("[import error] lines can only be read from fld text", FL_AT);
+        }
+        if (not std::getline(*_reader, line)) return false;
+        ++_lineNumber;
+        return true;
+    }
+
+    bool DataReader::read(std::vector<scalar>& inputValues) {
+        inputValues.clear();
+        if (not _reader) {
+            if (_overflow) return false;
+            for (int i = 0; i < _engine->numberOfInputVariables(); ++i) {
+                InputVariable* inputVariable = _engine->getInputVariable(i);
+                inputValues.push_back(inputVariable->getMinimum()
+                        + _sampleValues.at(i) * inputVariable->range() / std::max(1, _resolution));
+            }
+            _overflow = Op::increment(_sampleValues, _minSampleValues, _maxSampleValues);
+            return true;
+        }
+        if (_binary) {
+            if (_blockRow == _blockRows) {
+                _blockRows = _flbExporter.readColumns(*_reader, _columns, _singlePrecision,
+                        _inputColumns, _block);
+                _blockRow = 0;
+                if (_blockRows == 0) return false;
+            }
+            for (std::size_t i = 0; i < _inputColumns.size(); ++i) {
+                inputValues.push_back(_block.at(i * _blockRows + _blockRow));
+            }
+            ++_blockRow;
+            return true;
+        }
+        if (not readLine(_line)) return false;
+        _fldExporter.parse(_line.data(), _line.data() + _line.size(), inputValues);
+        return true;
+    }
+
+    std::size_t DataReader::read(std::vector<scalar>& inputValues, std::size_t rows) {
+        const std::size_t inputs = _engine->numberOfInputVariables();
+        inputValues.resize(inputs * rows);
+        std::size_t row = 0;
+        while (row < rows and read(_row)) {
+            if (_row.empty()) continue;
+            if (_row.size() < inputs) {
+                std::ostringstream ex;
+                ex << "[export error] engine has <" << inputs << "> input variables, "
+                        "but input data provides <" << _row.size() << "> values";
+                throw fl::Exception(ex.str(), FL_AT);
+            }
+            for (std::size_t i = 0; i < inputs; ++i) {
+                inputValues.at(i * rows + row) = _row.at(i);
+            }
+            ++row;
+        }
+        //the columns of a partial block are moved next to each other
+        for (std::size_t i = 1; i < inputs and row < rows; ++i) {
+            std::copy(inputValues.begin() + i * rows, inputValues.begin() + i * rows + row,
+                    inputValues.begin() + i * row);
+        }
+        inputValues.resize(inputs * row);
+        return row;
+    }
+
+}
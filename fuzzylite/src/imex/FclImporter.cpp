@@ -140,6 +140,7 @@ namespace fl {
             }
             throw fl::Exception(ex.str(), FL_AT);
         }
+        engine->restart();
         return engine.release();
     }
 
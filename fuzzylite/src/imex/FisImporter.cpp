@@ -102,6 +102,7 @@ namespace fl {
         engine->configure(extractTNorm(andMethod), extractSNorm(orMethod),
                 extractTNorm(impMethod), extractSNorm(aggMethod),
                 extractDefuzzifier(defuzzMethod));
+        engine->restart();
         return engine.release();
     }
 
@@ -0,0 +1,459 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "fl/imex/FlbExporter.h"
+
+#include "fl/Engine.h"
+#include "fl/Operation.h"
+#include "fl/imex/DataReader.h"
+#include "fl/variable/InputVariable.h"
+#include "fl/variable/OutputVariable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+
+namespace fl {
+
+    FlbExporter::FlbExporter() : Exporter(),
+    _exportInputValues(true), _exportOutputValues(true),
+    _singlePrecision(sizeof (scalar) == sizeof (float)), _rowsPerBlock(4096) {
+
+    }
+
+    FlbExporter::~FlbExporter() {
+    }
+
+    std::string FlbExporter::name() const {
+        return "FlbExporter";
+    }
+
+    void FlbExporter::setExportInputValues(bool exportInputValues) {
+        this->_exportInputValues = exportInputValues;
+    }
+
+    bool FlbExporter::exportsInputValues() const {
+        return this->_exportInputValues;
+    }
+
+    void FlbExporter::setExportOutputValues(bool exportOutputValues) {
+        this->_exportOutputValues = exportOutputValues;
+    }
+
+    bool FlbExporter::exportsOutputValues() const {
+        return this->_exportOutputValues;
+    }
+
+    void FlbExporter::setSinglePrecision(bool singlePrecision) {
+        this->_singlePrecision = singlePrecision;
+    }
+
+    bool FlbExporter::isSinglePrecision() const {
+        return this->_singlePrecision;
+    }
+
+    void FlbExporter::setRowsPerBlock(int rowsPerBlock) {
+        this->_rowsPerBlock = rowsPerBlock;
+    }
+
+    int FlbExporter::getRowsPerBlock() const {
+        return this->_rowsPerBlock;
+    }
+
+    std::string FlbExporter::header(const Engine* engine) const {
+        std::ostringstream writer;
+        writer.write("FLB1", 4);
+        writeUnsigned(writer, _singlePrecision ? 4 : 8);
+        writeString(writer, engine->getName());
+        writeUnsigned(writer, _exportInputValues ? engine->numberOfInputVariables() : 0);
+        if (_exportInputValues) {
+            for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+                writeString(writer, engine->getInputVariable(i)->getName());
+            }
+        }
+        writeUnsigned(writer, _exportOutputValues ? engine->numberOfOutputVariables() : 0);
+        if (_exportOutputValues) {
+            for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+                writeString(writer, engine->getOutputVariable(i)->getName());
+            }
+        }
+        writePadding(writer, writer.str().size());
+        return writer.str();
+    }
+
+    std::string FlbExporter::toString(const Engine* engine) const {
+        return toString(const_cast<Engine*> (engine), 1024);
+    }
+
+    std::string FlbExporter::toString(Engine* engine, int maximumNumberOfResults) const {
+        std::ostringstream writer;
+        write(engine, writer, maximumNumberOfResults);
+        return writer.str();
+    }
+
+    std::string FlbExporter::toString(Engine* engine, const std::string& inputData) const {
+        std::ostringstream writer;
+        std::istringstream reader(inputData);
+        write(engine, writer, reader);
+        return writer.str();
+    }
+
+    void FlbExporter::toFile(const std::string& path, const Engine* engine) const {
+        toFile(path, const_cast<Engine*> (engine), 1024);
+    }
+
+    void FlbExporter::toFile(const std::string& path, Engine* engine, int maximumNumberOfResults) const {
+        std::ofstream writer(path.c_str(), std::ios::out | std::ios::binary);
+        if (not writer.is_open()) {
+            throw fl::Exception("[file error] file <" + path + "> could not be created", FL_AT);
+        }
+        write(engine, writer, maximumNumberOfResults);
+        writer.close();
+    }
+
+    void FlbExporter::toFile(const std::string& path, Engine* engine, const std::string& inputData) const {
+        std::ofstream writer(path.c_str(), std::ios::out | std::ios::binary);
+        if (not writer.is_open()) {
+            throw fl::Exception("[file error] file <" + path + "> could not be created", FL_AT);
+        }
+        std::istringstream reader(inputData);
+        write(engine, writer, reader);
+        writer.close();
+    }
+
+    bool FlbExporter::isHeader(std::istream& reader) const {
+        std::streampos position = reader.tellg();
+        char magic[4];
+        reader.read(magic, 4);
+        bool result = reader.gcount() == 4 and std::memcmp(magic, "FLB1", 4) == 0;
+        reader.clear();
+        reader.seekg(position);
+        return result;
+    }
+
+    void FlbExporter::readHeader(std::istream& reader, std::string& engineName,
+            std::vector<std::string>& inputNames, std::vector<std::string>& outputNames,
+            bool& singlePrecision) const {
+        char magic[4];
+        reader.read(magic, 4);
+        if (reader.gcount() != 4 or std::memcmp(magic, "FLB1", 4) != 0) {
+            throw fl::Exception("[import error] binary data does not start with an flb header", FL_AT);
+        }
+        unsigned long bytes = readUnsigned(reader);
+        if (bytes != 4 and bytes != 8) {
+            throw fl::Exception("[import error] values of <" + Op::str(int(bytes)) + "> bytes "
+                    "not supported, only of 4 or 8 bytes", FL_AT);
+        }
+        singlePrecision = (bytes == 4);
+        engineName = readString(reader);
+        std::size_t size = 4 + 4 + 4 + engineName.size();
+        size += readStrings(reader, inputNames);
+        size += readStrings(reader, outputNames);
+        readPadding(reader, size);
+    }
+
+    std::size_t FlbExporter::readRows(std::istream& reader, std::size_t columns,
+            bool singlePrecision) const {
+        if (reader.peek() == std::char_traits<char>::eof()) {
+            return 0;
+        }
+        std::size_t rows = readUnsigned(reader);
+        readPadding(reader, 4);
+        //the number of rows is checked before allocating for them
+        std::streamoff bytes = remaining(reader);
+        if (bytes >= 0 and rows * columns > std::size_t(bytes) / (singlePrecision ? 4 : 8)) {
+            std::ostringstream ex;
+            ex << "[import error] block of <" << rows << "> rows and <" << columns << "> columns "
+                    "exceeds the <" << bytes << "> bytes left in the binary data";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        return rows;
+    }
+
+    std::size_t FlbExporter::readBlock(std::istream& reader, std::size_t columns,
+            bool singlePrecision, std::vector<scalar>& values) const {
+        std::size_t rows = readRows(reader, columns, singlePrecision);
+        values.resize(rows * columns);
+        if (not values.empty()) {
+            readValues(reader, &values.front(), values.size(), singlePrecision);
+        }
+        return rows;
+    }
+
+    std::size_t FlbExporter::readColumns(std::istream& reader, std::size_t columns,
+            bool singlePrecision, const std::vector<std::size_t>& selected,
+            std::vector<scalar>& values) const {
+        std::size_t rows = readRows(reader, columns, singlePrecision);
+        values.resize(selected.size() * rows);
+        if (rows == 0) return 0;
+        const std::streamsize bytes = std::streamsize(rows * (singlePrecision ? 4 : 8));
+        for (std::size_t column = 0; column < columns; ++column) {
+            //the column is read into its first selection, and copied into the others
+            std::size_t first = selected.size();
+            for (std::size_t i = 0; i < selected.size(); ++i) {
+                if (selected.at(i) != column) continue;
+                if (first == selected.size()) {
+                    first = i;
+                    readValues(reader, &values.at(i * rows), rows, singlePrecision);
+                } else {
+                    std::copy(values.begin() + first * rows, values.begin() + (first + 1) * rows,
+                            values.begin() + i * rows);
+                }
+            }
+            if (first == selected.size()) {
+                reader.ignore(bytes);
+                if (reader.gcount() != bytes) {
+                    throw fl::Exception("[import error] unexpected end of binary data", FL_AT);
+                }
+            }
+        }
+        return rows;
+    }
+
+    std::vector<std::size_t> FlbExporter::inputColumns(const Engine* engine,
+            const std::vector<std::string>& names) const {
+        std::vector<std::size_t> result;
+        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+            const std::string& name = engine->getInputVariable(i)->getName();
+            std::vector<std::string>::const_iterator it = std::find(names.begin(), names.end(), name);
+            if (it == names.end()) {
+                throw fl::Exception("[import error] input variable <" + name + "> "
+                        "not found in the columns of the binary data", FL_AT);
+            }
+            result.push_back(std::size_t(it - names.begin()));
+        }
+        return result;
+    }
+
+    void FlbExporter::write(Engine* engine, std::ostream& writer, int maximum) const {
+        DataReader data(engine, maximum);
+        write(engine, writer, data);
+    }
+
+    void FlbExporter::write(Engine* engine, std::ostream& writer, std::istream& reader) const {
+        DataReader data(engine, reader);
+        write(engine, writer, data);
+    }
+
+    void FlbExporter::write(Engine* engine, std::ostream& writer, DataReader& data) const {
+        std::string header = this->header(engine);
+        writer.write(header.data(), header.size());
+
+        engine->restart();
+
+        const std::size_t rowsPerBlock = std::max(1, _rowsPerBlock);
+        std::vector<scalar> inputValues;
+        while (true) {
+            std::size_t rows;
+            try {
+                rows = data.read(inputValues, rowsPerBlock);
+            } catch (fl::Exception& ex) {
+                if (data.readsLines()) ex.append(" writing line <" + Op::str(data.getLineNumber()) + ">");
+                throw;
+            }
+            if (rows == 0) break;
+            write(engine, writer, inputValues, rows);
+        }
+    }
+
+    void FlbExporter::write(Engine* engine, std::ostream& writer,
+            std::vector<scalar>& inputValues, std::size_t rows) const {
+        if (rows == 0) return;
+        const std::size_t inputs = engine->numberOfInputVariables();
+        const std::size_t outputs = engine->numberOfOutputVariables();
+        if (inputValues.size() < inputs * rows) {
+            std::ostringstream ex;
+            ex << "[export error] engine has <" << inputs << "> input variables, "
+                    "but input data provides <" << inputValues.size() << "> values "
+                    "for <" << rows << "> rows";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        for (std::size_t i = 0; i < inputs; ++i) {
+            if (not engine->getInputVariable(int(i))->isEnabled()) {
+                std::fill(inputValues.begin() + i * rows, inputValues.begin() + (i + 1) * rows, fl::nan);
+            }
+        }
+
+        std::vector<scalar> outputValues(outputs * rows);
+        engine->process(inputs ? &inputValues.front() : fl::null, rows,
+                outputs ? &outputValues.front() : fl::null);
+
+        writeUnsigned(writer, rows);
+        writePadding(writer, 4);
+        if (_exportInputValues and inputs > 0) {
+            writeValues(writer, &inputValues.front(), inputs * rows);
+        }
+        if (_exportOutputValues and outputs > 0) {
+            writeValues(writer, &outputValues.front(), outputs * rows);
+        }
+    }
+
+    void FlbExporter::writeUnsigned(std::ostream& writer, unsigned long x) const {
+        char bytes[4];
+        for (int i = 0; i < 4; ++i) {
+            bytes[i] = char((x >> (8 * i)) & 0xff);
+        }
+        writer.write(bytes, 4);
+    }
+
+    unsigned long FlbExporter::readUnsigned(std::istream& reader) const {
+        unsigned char bytes[4];
+        reader.read(reinterpret_cast<char*> (bytes), 4);
+        if (reader.gcount() != 4) {
+            throw fl::Exception("[import error] unexpected end of binary data", FL_AT);
+        }
+        unsigned long result = 0;
+        for (int i = 3; i >= 0; --i) {
+            result = (result << 8) | bytes[i];
+        }
+        return result;
+    }
+
+    void FlbExporter::writeString(std::ostream& writer, const std::string& x) const {
+        writeUnsigned(writer, x.size());
+        writer.write(x.data(), x.size());
+    }
+
+    std::string FlbExporter::readString(std::istream& reader) const {
+        const std::size_t size = readUnsigned(reader);
+        std::streamoff bytes = remaining(reader);
+        if (bytes >= 0 and size > std::size_t(bytes)) {
+            std::ostringstream ex;
+            ex << "[import error] string of <" << size << "> bytes "
+                    "exceeds the <" << bytes << "> bytes left in the binary data";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        //if the size of the data is unknown, the string grows only as it is read
+        std::string result;
+        char buffer[1024];
+        while (result.size() < size) {
+            const std::streamsize chunk = std::streamsize(
+                    std::min(size - result.size(), sizeof (buffer)));
+            reader.read(buffer, chunk);
+            if (reader.gcount() != chunk) {
+                throw fl::Exception("[import error] unexpected end of binary data", FL_AT);
+            }
+            result.append(buffer, std::size_t(chunk));
+        }
+        return result;
+    }
+
+    std::size_t FlbExporter::readStrings(std::istream& reader, std::vector<std::string>& strings) const {
+        const std::size_t size = readUnsigned(reader);
+        //every string takes at least the 4 bytes of its length
+        std::streamoff bytes = remaining(reader);
+        if (bytes >= 0 and size > std::size_t(bytes) / 4) {
+            std::ostringstream ex;
+            ex << "[import error] <" << size << "> strings "
+                    "exceed the <" << bytes << "> bytes left in the binary data";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        strings.clear();
+        std::size_t result = 4;
+        for (std::size_t i = 0; i < size; ++i) {
+            strings.push_back(readString(reader));
+            result += 4 + strings.back().size();
+        }
+        return result;
+    }
+
+    void FlbExporter::writeValues(std::ostream& writer, const scalar* values, std::size_t n) const {
+        const unsigned int one = 1;
+        const bool littleEndian = *reinterpret_cast<const unsigned char*> (&one) == 1;
+        const std::size_t bytes = _singlePrecision ? 4 : 8;
+        std::vector<char> buffer(n * bytes);
+        for (std::size_t i = 0; i < n; ++i) {
+            char* value = &buffer[i * bytes];
+            if (_singlePrecision) {
+                float x = float(values[i]);
+                std::memcpy(value, &x, bytes);
+            } else {
+                double x = double(values[i]);
+                std::memcpy(value, &x, bytes);
+            }
+            if (not littleEndian) std::reverse(value, value + bytes);
+        }
+        writer.write(&buffer.front(), buffer.size());
+    }
+
+    void FlbExporter::readValues(std::istream& reader, scalar* values, std::size_t n,
+            bool singlePrecision) const {
+        const unsigned int one = 1;
+        const bool littleEndian = *reinterpret_cast<const unsigned char*> (&one) == 1;
+        const std::size_t bytes = singlePrecision ? 4 : 8;
+        std::vector<char> buffer(n * bytes);
+        reader.read(&buffer.front(), buffer.size());
+        if (reader.gcount() != std::streamsize(buffer.size())) {
+            throw fl::Exception("[import error] unexpected end of binary data", FL_AT);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            char* value = &buffer[i * bytes];
+            if (not littleEndian) std::reverse(value, value + bytes);
+            if (singlePrecision) {
+                float x;
+                std::memcpy(&x, value, bytes);
+                values[i] = scalar(x);
+            } else {
+                double x;
+                std::memcpy(&x, value, bytes);
+                values[i] = scalar(x);
+            }
+        }
+    }
+
+    void FlbExporter::writePadding(std::ostream& writer, std::size_t size) const {
+        const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        writer.write(zeros, std::streamsize((8 - size % 8) % 8));
+    }
+
+    void FlbExporter::readPadding(std::istream& reader, std::size_t size) const {
+        char zeros[8];
+        const std::streamsize bytes = std::streamsize((8 - size % 8) % 8);
+        reader.read(zeros, bytes);
+        if (reader.gcount() != bytes) {
+            throw fl::Exception("[import error] unexpected end of binary data", FL_AT);
+        }
+    }
+
+    std::streamoff FlbExporter::remaining(std::istream& reader) const {
+        std::streampos position = reader.tellg();
+        if (position == std::streampos(-1)) return -1;
+        reader.seekg(0, std::ios::end);
+        std::streampos end = reader.tellg();
+        reader.seekg(position);
+        if (end == std::streampos(-1) or not reader) {
+            reader.clear();
+            reader.seekg(position);
+            return -1;
+        }
+        return std::streamoff(end - position);
+    }
+
+    FlbExporter* FlbExporter::clone() const {
+        return new FlbExporter(*this);
+    }
+
+}
@@ -24,21 +24,118 @@
 
 #include "fl/imex/FldExporter.h"
 
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/Operation.h"
+#include "fl/imex/DataReader.h"
+#include "fl/term/Function.h"
 #include "fl/variable/Variable.h"
 #include "fl/variable/InputVariable.h"
 #include "fl/variable/OutputVariable.h"
 
+#include <cctype>
 #include <cmath>
 #include <fstream>
 #include <vector>
 
+#ifdef FL_CPP11
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace fl {
 
+    class FldExporter::Workers {
+    public:
+        std::vector<Context> contexts;
+#ifdef FL_CPP11
+        //Rows written by each worker in the last batch, and the error that stopped it
+        std::vector<std::string> outputs;
+        std::vector<std::exception_ptr> errors;
+
+        Workers(const Engine* engine, std::size_t size) : contexts(size, Context(engine)),
+        outputs(size), errors(size), _generation(0), _pending(0), _stopped(false) {
+            try {
+                for (std::size_t p = 0; p < size; ++p) {
+                    _threads.push_back(std::thread(&Workers::work, this, p));
+                }
+            } catch (...) {
+                stop();
+                throw;
+            }
+        }
+
+        ~Workers() {
+            stop();
+        }
+
+        //Runs the task on every worker (given its index), and waits for all of them
+        void run(const std::function<void(std::size_t)>& task) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _task = &task;
+            _pending = _threads.size();
+            ++_generation;
+            _started.notify_all();
+            _finished.wait(lock, [this]() {
+                return _pending == 0;
+            });
+            _task = fl::null;
+        }
+
+    private:
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _started, _finished;
+        const std::function<void(std::size_t)>* _task;
+        unsigned long _generation;
+        std::size_t _pending;
+        bool _stopped;
+
+        void work(std::size_t p) {
+            unsigned long generation = 0;
+            while (true) {
+                const std::function<void(std::size_t)>* task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _started.wait(lock, [&]() {
+                        return _stopped or _generation != generation;
+                    });
+                    if (_stopped) return;
+                    generation = _generation;
+                    task = _task;
+                }
+                (*task)(p);
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_pending == 0) _finished.notify_one();
+            }
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopped = true;
+            }
+            _started.notify_all();
+            for (std::size_t p = 0; p < _threads.size(); ++p) {
+                _threads.at(p).join();
+            }
+        }
+#else
+
+        Workers(const Engine* engine, std::size_t size) : contexts(size, Context(engine)) {
+        }
+#endif
+    };
+
+    FldExporter::Batch::Batch() : size(0), parseLines(false), firstLine(-1) {
+    }
+
     FldExporter::FldExporter(const std::string& separator) : Exporter(),
     _separator(separator), _exportHeaders(true),
-    _exportInputValues(true), _exportOutputValues(true) {
+    _exportInputValues(true), _exportOutputValues(true), _threads(1) {
 
     }
 
@@ -81,6 +178,14 @@ namespace fl {
         return this->_exportOutputValues;
     }
 
+    void FldExporter::setThreads(int threads) {
+        this->_threads = threads;
+    }
+
+    int FldExporter::getThreads() const {
+        return this->_threads;
+    }
+
     std::string FldExporter::header(const Engine* engine) const {
         std::vector<std::string> result;
         if (_exportInputValues) {
@@ -120,15 +225,7 @@ namespace fl {
     std::string FldExporter::toString(Engine* engine, const std::string& inputData) const {
         std::ostringstream writer;
         if (_exportHeaders) writer << header(engine) << "\n";
-        std::istringstream reader(inputData);
-        std::string line;
-        while (std::getline(reader, line)) {
-            line = Op::trim(line);
-            if (not line.empty() and line.at(0) == '#') continue; //comments are ignored, blank lines are retained
-            std::vector<scalar> inputValues = parse(line);
-            write(engine, writer, inputValues);
-            writer.flush();
-        }
+        writeData(engine, writer, inputData);
         return writer.str();
     }
 
@@ -138,70 +235,90 @@ namespace fl {
             throw fl::Exception("[file error] file <" + path + "> could not be created", FL_AT);
         }
         if (_exportHeaders) writer << header(engine) << "\n";
-        std::istringstream reader(inputData);
-        std::string line;
-        while (std::getline(reader, line)) {
-            line = Op::trim(line);
-            if (not line.empty() and line.at(0) == '#') continue; //comments are ignored, blank lines are retained
-            std::vector<scalar> inputValues = parse(line);
+        writeData(engine, writer, inputData);
+        writer.close();
+    }
+
+    void FldExporter::writeData(Engine* engine, std::ostream& writer, const std::string& inputData) const {
+        std::vector<scalar> inputValues;
+        const char* data = inputData.data();
+        std::size_t begin = 0;
+        while (begin < inputData.size()) {
+            std::size_t end = inputData.find('\n', begin);
+            if (end == std::string::npos) end = inputData.size();
+            const char* first = data + begin;
+            const char* last = data + end;
+            while (first != last and std::isspace((unsigned char) *first)) ++first;
+            begin = end + 1;
+            if (first != last and *first == '#') continue; //comments are ignored, blank lines are retained
+            inputValues.clear();
+            parse(first, last, inputValues);
             write(engine, writer, inputValues);
-            writer.flush();
         }
-        writer.close();
     }
 
     std::vector<scalar> FldExporter::parse(const std::string& x) const {
         std::vector<scalar> inputValues;
         if (not (x.empty() or x.at(0) == '#')) {
-            std::istringstream tokenizer(x);
-            std::string token;
-            while (tokenizer >> token)
-                inputValues.push_back(fl::Op::toScalar(token));
+            parse(x.data(), x.data() + x.size(), inputValues);
         }
         return inputValues;
     }
 
-    void FldExporter::write(Engine* engine, std::ostream& writer, int maximum) const {
-        if (_exportHeaders) writer << header(engine) << "\n";
-
-        int resolution = -1 + (int) std::max(1.0, std::pow(
-                maximum, 1.0 / engine->numberOfInputVariables()));
-        std::vector<int> sampleValues, minSampleValues, maxSampleValues;
-        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
-            sampleValues.push_back(0);
-            minSampleValues.push_back(0);
-            maxSampleValues.push_back(resolution);
+    void FldExporter::parse(const char* begin, const char* end, std::vector<scalar>& values) const {
+        const char* token = begin;
+        while (token != end and std::isspace((unsigned char) *token)) ++token;
+        if (token != end and *token == '#') return;
+        while (token != end) {
+            const char* tokenEnd = token;
+            while (tokenEnd != end and not std::isspace((unsigned char) *tokenEnd)) ++tokenEnd;
+            values.push_back(Op::parseScalar(token, tokenEnd));
+            token = tokenEnd;
+            while (token != end and std::isspace((unsigned char) *token)) ++token;
         }
+    }
 
-        engine->restart();
-
-        bool overflow = false;
-        std::vector<scalar> inputValues(engine->numberOfInputVariables());
-        while (not overflow) {
-            for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
-                InputVariable* inputVariable = engine->getInputVariable(i);
-                inputValues.at(i) = inputVariable->getMinimum()
-                        + sampleValues.at(i) * inputVariable->range() / std::max(1, resolution);
-            }
-            write(engine, writer, inputValues);
-            overflow = Op::increment(sampleValues, minSampleValues, maxSampleValues);
-        }
+    void FldExporter::write(Engine* engine, std::ostream& writer, int maximum) const {
+        DataReader data(engine, maximum);
+        write(engine, writer, data);
     }
 
     void FldExporter::write(Engine* engine, std::ostream& writer, std::istream& reader) const {
+        DataReader data(engine, reader);
+        write(engine, writer, data);
+    }
+
+    void FldExporter::write(Engine* engine, std::ostream& writer, DataReader& data) const {
         if (_exportHeaders) writer << header(engine) << "\n";
 
         engine->restart();
 
-        std::string line;
-        int lineNumber = 0;
-        while (std::getline(reader, line)) {
-            ++lineNumber;
-            std::vector<scalar> inputValues = parse(Op::trim(line));
+        if (_threads > 1 and isParallelizable(engine)) {
+            Workers workers(engine, _threads);
+            //the lines are read into the same strings, and parsed by the workers, in every batch
+            Batch batch;
+            batch.parseLines = data.readsLines();
+            batch.rows.resize(4096 * workers.contexts.size());
+            if (batch.parseLines) batch.lines.resize(batch.rows.size());
+            do {
+                batch.firstLine = batch.parseLines ? data.getLineNumber() + 1 : -1;
+                batch.size = 0;
+                while (batch.size < batch.rows.size() and (batch.parseLines
+                        ? data.readLine(batch.lines.at(batch.size))
+                        : data.read(batch.rows.at(batch.size)))) {
+                    ++batch.size;
+                }
+                write(engine, writer, batch, workers);
+            } while (batch.size == batch.rows.size());
+            return;
+        }
+        std::vector<scalar> inputValues;
+        while (true) {
             try {
+                if (not data.read(inputValues)) break;
                 write(engine, writer, inputValues);
             } catch (fl::Exception& ex) {
-                ex.append(" writing line <" + Op::str(lineNumber) + ">");
+                if (data.readsLines()) ex.append(" writing line <" + Op::str(data.getLineNumber()) + ">");
                 throw;
             }
         }
@@ -219,12 +336,15 @@ namespace fl {
             throw fl::Exception(ex.str(), FL_AT);
         }
 
-        std::vector<std::string> values;
+        std::string row;
         for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
             InputVariable* inputVariable = engine->getInputVariable(i);
             scalar inputValue = inputVariable->isEnabled() ? inputValues.at(i) : fl::nan;
             inputVariable->setInputValue(inputValue);
-            if (_exportInputValues) values.push_back(Op::str(inputValue));
+            if (_exportInputValues) {
+                if (i > 0) row += _separator;
+                Op::str(inputValue, fuzzylite::decimals(), row);
+            }
         }
 
         engine->process();
@@ -232,11 +352,120 @@ namespace fl {
         for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
             OutputVariable* outputVariable = engine->getOutputVariable(i);
             outputVariable->defuzzify();
-            if (_exportOutputValues)
-                values.push_back(Op::str(outputVariable->getOutputValue()));
+            if (_exportOutputValues) {
+                if (not row.empty()) row += _separator;
+                Op::str(outputVariable->getOutputValue(), fuzzylite::decimals(), row);
+            }
         }
+        row += "\n";
+        writer.write(row.data(), row.size());
+    }
 
-        writer << Op::join(values, _separator) << "\n";
+    void FldExporter::write(const Engine* engine, Context& context, std::ostream& writer,
+            const std::vector<scalar>& inputValues) const {
+        if (inputValues.empty()) {
+            writer << "\n";
+            return;
+        }
+        if (int(inputValues.size()) < engine->numberOfInputVariables()) {
+            std::ostringstream ex;
+            ex << "[export error] engine has <" << engine->numberOfInputVariables() << "> "
+                    "input variables, but input data provides <" << inputValues.size() << "> values";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+
+        std::string row;
+        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+            InputVariable* inputVariable = engine->getInputVariable(i);
+            scalar inputValue = inputVariable->isEnabled() ? inputValues.at(i) : fl::nan;
+            context.setInputValue(i, inputValue);
+            if (_exportInputValues) {
+                if (i > 0) row += _separator;
+                Op::str(inputValue, fuzzylite::decimals(), row);
+            }
+        }
+
+        engine->process(context);
+
+        if (_exportOutputValues) {
+            for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+                if (not row.empty()) row += _separator;
+                Op::str(context.getOutputValue(i), fuzzylite::decimals(), row);
+            }
+        }
+        row += "\n";
+        writer.write(row.data(), row.size());
+    }
+
+    bool FldExporter::isParallelizable(const Engine* engine) const {
+        for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+            if (engine->getOutputVariable(i)->isLockedPreviousOutputValue()) return false;
+        }
+        std::vector<const Variable*> variables;
+        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+            variables.push_back(engine->getInputVariable(i));
+        }
+        for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+            variables.push_back(engine->getOutputVariable(i));
+        }
+        //Functions read the output values of the previous row, or the engine if not compiled
+        for (std::size_t v = 0; v < variables.size(); ++v) {
+            for (int t = 0; t < variables.at(v)->numberOfTerms(); ++t) {
+                const Function* function = dynamic_cast<const Function*> (variables.at(v)->getTerm(t));
+                if (not function) continue;
+                if (not function->isCompiled()) return false;
+                for (std::size_t i = 0; i < function->instructions().size(); ++i) {
+                    if (function->instructions().at(i).opcode == Function::Instruction::OutputValue)
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void FldExporter::write(const Engine* engine, Context& context, std::ostream& writer,
+            Batch& batch, std::size_t first, std::size_t last) const {
+        for (std::size_t row = first; row < last; ++row) {
+            try {
+                std::vector<scalar>& inputValues = batch.rows.at(row);
+                if (batch.parseLines) {
+                    const std::string& line = batch.lines.at(row);
+                    inputValues.clear();
+                    parse(line.data(), line.data() + line.size(), inputValues);
+                }
+                write(engine, context, writer, inputValues);
+            } catch (fl::Exception& ex) {
+                if (batch.firstLine >= 0)
+                    ex.append(" writing line <" + Op::str(batch.firstLine + int(row)) + ">");
+                throw;
+            }
+        }
+    }
+
+    void FldExporter::write(const Engine* engine, std::ostream& writer,
+            Batch& batch, Workers& workers) const {
+#ifdef FL_CPP11
+        const std::size_t partitions = std::min(workers.contexts.size(), batch.size);
+        workers.run([&](std::size_t p) {
+            if (p >= partitions) return;
+            std::ostringstream output;
+            workers.errors.at(p) = std::exception_ptr();
+            try {
+                write(engine, workers.contexts.at(p), output, batch,
+                        p * batch.size / partitions, (p + 1) * batch.size / partitions);
+            } catch (...) {
+                workers.errors.at(p) = std::current_exception();
+            }
+            workers.outputs.at(p) = output.str();
+        });
+        //the rows before an error are written, as when evaluating serially
+        for (std::size_t p = 0; p < partitions; ++p) {
+            writer << workers.outputs.at(p);
+            if (workers.errors.at(p)) std::rethrow_exception(workers.errors.at(p));
+        }
+#else
+        write(engine, workers.contexts.front(), writer, batch, 0, batch.size);
+#endif
     }
 
     FldExporter* FldExporter::clone() const {
@@ -101,6 +101,7 @@ namespace fl {
             block << key << ":" << value << "\n";
         }
         process(tag, block.str(), engine.get());
+        engine->restart();
         return engine.release();
     }
 
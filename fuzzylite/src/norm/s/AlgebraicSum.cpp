@@ -34,6 +34,17 @@ namespace fl {
         return a + b - (a * b);
     }
 
+    AlgebraicSum::Kernel AlgebraicSum::kernel() const {
+        return AlgebraicSumKernel;
+    }
+
+    void AlgebraicSum::compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar ai = a[i], bi = b[i];
+            c[i] = ai + bi - (ai * bi);
+        }
+    }
+
     AlgebraicSum* AlgebraicSum::clone() const {
         return new AlgebraicSum(*this);
     }
@@ -34,6 +34,17 @@ namespace fl {
         return Op::min(scalar(1.0), a + b);
     }
 
+    BoundedSum::Kernel BoundedSum::kernel() const {
+        return BoundedSumKernel;
+    }
+
+    void BoundedSum::compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar sum = a[i] + b[i];
+            c[i] = (sum != sum or scalar(1.0) < sum) ? scalar(1.0) : sum;
+        }
+    }
+
     BoundedSum* BoundedSum::clone() const {
         return new BoundedSum(*this);
     }
@@ -34,6 +34,16 @@ namespace fl {
         return a * b;
     }
 
+    AlgebraicProduct::Kernel AlgebraicProduct::kernel() const {
+        return AlgebraicProductKernel;
+    }
+
+    void AlgebraicProduct::compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            c[i] = a[i] * b[i];
+        }
+    }
+
     AlgebraicProduct* AlgebraicProduct::clone() const {
         return new AlgebraicProduct(*this);
     }
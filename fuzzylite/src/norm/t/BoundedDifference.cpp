@@ -35,6 +35,17 @@ namespace fl {
         return Op::max(scalar(0.0), a + b - scalar(1.0));
     }
 
+    BoundedDifference::Kernel BoundedDifference::kernel() const {
+        return BoundedDifferenceKernel;
+    }
+
+    void BoundedDifference::compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar sum = a[i] + b[i] - scalar(1.0);
+            c[i] = (sum != sum or scalar(0.0) > sum) ? scalar(0.0) : sum;
+        }
+    }
+
     BoundedDifference* BoundedDifference::clone() const {
         return new BoundedDifference(*this);
     }
@@ -34,6 +34,17 @@ namespace fl {
         return Op::min(a, b);
     }
 
+    Minimum::Kernel Minimum::kernel() const {
+        return MinimumKernel;
+    }
+
+    void Minimum::compute(const scalar* a, const scalar* b, scalar* c, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar ai = a[i], bi = b[i];
+            c[i] = (ai != ai) ? bi : ((bi != bi) ? ai : (ai < bi ? ai : bi));
+        }
+    }
+
     Minimum* Minimum::clone() const {
         return new Minimum(*this);
     }
@@ -24,6 +24,7 @@
 
 #include "fl/rule/Antecedent.h"
 
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/factory/HedgeFactory.h"
 #include "fl/factory/FactoryManager.h"
@@ -46,7 +47,7 @@
 namespace fl {
 
     Antecedent::Antecedent()
-    : _text(""), _expression(fl::null) {
+    : _text(""), _expression(fl::null), _stackSize(0), _revision(0) {
     }
 
     Antecedent::~Antecedent() {
@@ -135,11 +136,169 @@ namespace fl {
 
     }
 
+    scalar Antecedent::activationDegree(const TNorm* conjunction, const SNorm* disjunction,
+            Context& context) const {
+        if (not isLoaded()) {
+            throw fl::Exception("[antecedent error] antecedent <" + _text + "> is not loaded", FL_AT);
+        }
+        scalar buffer[16] = {0.0};
+        std::vector<scalar> heapBuffer;
+        scalar* stack = buffer;
+        if (_stackSize > 16) {
+            heapBuffer.resize(_stackSize);
+            stack = &heapBuffer[0];
+        }
+        std::size_t top = 0;
+        const bool compiled = (_revision == context.getRevision());
+
+        for (std::size_t i = 0; i < _instructions.size(); ++i) {
+            const Instruction& instruction = _instructions[i];
+            if (instruction.opcode == Instruction::Conjunction) {
+                if (not conjunction) throw fl::Exception("[conjunction error] "
+                        "the following rule requires a conjunction operator:\n" + _text, FL_AT);
+                --top;
+                stack[top - 1] = conjunction->compute(stack[top - 1], stack[top]);
+                continue;
+            }
+            if (instruction.opcode == Instruction::Disjunction) {
+                if (not disjunction) throw fl::Exception("[disjunction error] "
+                        "the following rule requires a disjunction operator:\n" + _text, FL_AT);
+                --top;
+                stack[top - 1] = disjunction->compute(stack[top - 1], stack[top]);
+                continue;
+            }
+
+            scalar result;
+            if (not instruction.variable->isEnabled()) {
+                result = 0.0;
+            } else if (instruction.opcode == Instruction::Constant) {
+                result = instruction.value;
+            } else {
+                if (not compiled) {
+                    //the indices and slots may no longer match the structure of the engine
+                    if (instruction.opcode == Instruction::InputTerm) {
+                        result = instruction.term->membership(context.getInputValue(
+                                static_cast<const InputVariable*> (instruction.variable)), context);
+                    } else {
+                        result = context.fuzzyOutput(static_cast<const OutputVariable*> (
+                                instruction.variable))->activationDegree(instruction.term);
+                    }
+                } else if (instruction.opcode == Instruction::InputTerm) {
+                    scalar& membership = context.memberships()[instruction.slot];
+                    if (Op::isNaN(membership)) {
+                        membership = instruction.term->membership(
+                                context.inputValues()[instruction.index], context);
+                    }
+                    result = membership;
+                } else {
+                    result = context.fuzzyOutput(instruction.index)->activationDegree(instruction.term);
+                }
+                for (std::size_t h = instruction.firstHedge; h < instruction.lastHedge; ++h) {
+                    result = _hedges[h]->hedge(result);
+                }
+            }
+            stack[top++] = result;
+        }
+        return stack[0];
+    }
+
+    Antecedent::Instruction::Instruction(Opcode opcode)
+    : opcode(opcode), variable(fl::null), index(-1), term(fl::null), slot(-1), value(fl::nan),
+    firstHedge(0), lastHedge(0) {
+    }
+
+    void Antecedent::compile(const Engine* engine) {
+        _instructions.clear();
+        _hedges.clear();
+        _stackSize = 0;
+        _revision = engine->revision();
+        if (_expression) compile(_expression, engine, 1);
+    }
+
+    void Antecedent::compile(const Expression* node, const Engine* engine, std::size_t depth) {
+        _stackSize = std::max(_stackSize, depth);
+        if (const Proposition * proposition = dynamic_cast<const Proposition*> (node)) {
+            Instruction instruction;
+            instruction.variable = proposition->variable;
+            instruction.term = proposition->term;
+            if (InputVariable * inputVariable = dynamic_cast<InputVariable*> (proposition->variable)) {
+                instruction.opcode = Instruction::InputTerm;
+                const std::vector<InputVariable*>& inputVariables = engine->inputVariables();
+                instruction.index = std::find(inputVariables.begin(), inputVariables.end(),
+                        inputVariable) - inputVariables.begin();
+                if (instruction.index == (int) inputVariables.size()) {
+                    instruction.index = -1;
+                } else {
+                    instruction.slot = 0;
+                    for (int i = 0; i < instruction.index; ++i) {
+                        instruction.slot += inputVariables.at(i)->numberOfTerms();
+                    }
+                    const std::vector<Term*>& terms = static_cast<const Variable*> (inputVariable)->terms();
+                    instruction.slot += std::find(terms.begin(), terms.end(),
+                            proposition->term) - terms.begin();
+                }
+            } else if (OutputVariable * outputVariable = dynamic_cast<OutputVariable*> (proposition->variable)) {
+                instruction.opcode = Instruction::OutputTerm;
+                const std::vector<OutputVariable*>& outputVariables = engine->outputVariables();
+                instruction.index = std::find(outputVariables.begin(), outputVariables.end(),
+                        outputVariable) - outputVariables.begin();
+                if (instruction.index == (int) outputVariables.size()) instruction.index = -1;
+            }
+            if (instruction.index < 0) {
+                throw fl::Exception("[antecedent error] variable <" + proposition->variable->getName()
+                        + "> not found in engine", FL_AT);
+            }
+
+            std::vector<Hedge*>::const_reverse_iterator rit = proposition->hedges.rbegin();
+            if (rit != proposition->hedges.rend() and dynamic_cast<Any*> (*rit)) {
+                //if last hedge is "Any", apply hedges in reverse order to compute the degree
+                instruction.opcode = Instruction::Constant;
+                instruction.value = (*rit)->hedge(fl::nan);
+                while (++rit != proposition->hedges.rend()) {
+                    instruction.value = (*rit)->hedge(instruction.value);
+                }
+            } else {
+                instruction.firstHedge = _hedges.size();
+                _hedges.insert(_hedges.end(), proposition->hedges.rbegin(), proposition->hedges.rend());
+                instruction.lastHedge = _hedges.size();
+            }
+            _instructions.push_back(instruction);
+            return;
+        }
+
+        const Operator* fuzzyOperator = dynamic_cast<const Operator*> (node);
+        if (not (fuzzyOperator and fuzzyOperator->left and fuzzyOperator->right)) {
+            std::ostringstream ex;
+            ex << "[syntax error] left and right operands must exist";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        Instruction instruction;
+        if (fuzzyOperator->name == Rule::andKeyword()) {
+            instruction.opcode = Instruction::Conjunction;
+        } else if (fuzzyOperator->name == Rule::orKeyword()) {
+            instruction.opcode = Instruction::Disjunction;
+        } else {
+            std::ostringstream ex;
+            ex << "[syntax error] operator <" << fuzzyOperator->name << "> not recognized";
+            throw fl::Exception(ex.str(), FL_AT);
+        }
+        compile(fuzzyOperator->left, engine, depth);
+        compile(fuzzyOperator->right, engine, depth + 1);
+        _instructions.push_back(instruction);
+    }
+
+    const std::vector<Antecedent::Instruction>& Antecedent::instructions() const {
+        return this->_instructions;
+    }
+
     void Antecedent::unload() {
         if (_expression) {
             delete _expression;
             _expression = fl::null;
         }
+        _instructions.clear();
+        _hedges.clear();
+        _stackSize = 0;
     }
 
     void Antecedent::load(fl::Rule* rule, const Engine* engine) {
@@ -309,6 +468,12 @@ namespace fl {
             throw;
         }
         this->_expression = expressionStack.top();
+        try {
+            compile(engine);
+        } catch (...) {
+            unload();
+            throw;
+        }
     }
 
     std::string Antecedent::toString() const {
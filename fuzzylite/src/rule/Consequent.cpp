@@ -24,6 +24,7 @@
 
 #include "fl/rule/Consequent.h"
 
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/factory/HedgeFactory.h"
 #include "fl/factory/FactoryManager.h"
@@ -40,7 +41,7 @@
 
 namespace fl {
 
-    Consequent::Consequent() {
+    Consequent::Consequent() : _revision(0) {
     }
 
     Consequent::~Consequent() {
@@ -72,9 +73,34 @@ namespace fl {
                         activationDegree = (*rit)->hedge(activationDegree);
                     }
                 }
-                Activated* term = new Activated(_conclusions.at(i)->term, activationDegree, activation);
                 OutputVariable* outputVariable = dynamic_cast<OutputVariable*> (proposition->variable);
-                outputVariable->fuzzyOutput()->addTerm(term);
+                Activated* term = outputVariable->fuzzyOutput()->addTerm(
+                        proposition->term, activationDegree, activation);
+                term->setTermIndex(_termIndices.at(i));
+                FL_DBG("Accumulating " << term->toString());
+            }
+        }
+    }
+
+    void Consequent::modify(scalar activationDegree, const TNorm* activation, Context& context) {
+        if (not isLoaded()) {
+            throw fl::Exception("[consequent error] consequent <" + _text + "> is not loaded", FL_AT);
+        }
+        for (std::size_t i = 0; i < _conclusions.size(); ++i) {
+            Proposition* proposition = _conclusions.at(i);
+            if (proposition->variable->isEnabled()) {
+                if (not proposition->hedges.empty()) {
+                    for (std::vector<Hedge*>::const_reverse_iterator rit = proposition->hedges.rbegin();
+                            rit != proposition->hedges.rend(); ++rit) {
+                        activationDegree = (*rit)->hedge(activationDegree);
+                    }
+                }
+                const bool compiled = (_revision == context.getRevision());
+                Accumulated* fuzzyOutput = compiled ? context.fuzzyOutput(_outputIndices.at(i))
+                        : context.fuzzyOutput(static_cast<const OutputVariable*> (proposition->variable));
+                Activated* term = fuzzyOutput->addTerm(proposition->term, activationDegree, activation);
+                term->setTermIndex(compiled ? _termIndices.at(i) : -1);
+                term->setContext(&context);
                 FL_DBG("Accumulating " << term->toString());
             }
         }
@@ -89,6 +115,8 @@ namespace fl {
             delete _conclusions.at(i);
         }
         _conclusions.clear();
+        _outputIndices.clear();
+        _termIndices.clear();
     }
 
     void Consequent::load(Rule* rule, const Engine* engine) {
@@ -224,12 +252,33 @@ namespace fl {
                     throw fl::Exception(ex.str(), FL_AT);
                 }
             }
+
+            compile(engine);
         } catch (...) {
             unload();
             throw;
         }
     }
 
+    void Consequent::compile(const Engine* engine) {
+        //Resolves the indices of the output variables and terms to group the activated terms
+        _outputIndices.clear();
+        _termIndices.clear();
+        _revision = engine->revision();
+        for (std::size_t i = 0; i < _conclusions.size(); ++i) {
+            const Proposition* conclusion = _conclusions.at(i);
+            const std::vector<OutputVariable*>& outputVariables = engine->outputVariables();
+            int outputIndex = std::find(outputVariables.begin(), outputVariables.end(),
+                    conclusion->variable) - outputVariables.begin();
+            const Variable* variable = conclusion->variable;
+            const std::vector<Term*>& terms = variable->terms();
+            int termIndex = std::find(terms.begin(), terms.end(),
+                    conclusion->term) - terms.begin();
+            _outputIndices.push_back(outputIndex);
+            _termIndices.push_back(termIndex == int(terms.size()) ? -1 : termIndex);
+        }
+    }
+
     std::string Consequent::toString() const {
         std::stringstream ss;
         for (std::size_t i = 0; i < _conclusions.size(); ++i) {
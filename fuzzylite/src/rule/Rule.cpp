@@ -152,6 +152,21 @@ namespace fl {
         _consequent->modify(degree, activation);
     }
 
+    scalar Rule::activationDegree(const TNorm* conjunction, const SNorm* disjunction,
+            Context& context) const {
+        if (not isLoaded()) {
+            throw fl::Exception("[rule error] the following rule is not loaded: " + _text, FL_AT);
+        }
+        return _weight * getAntecedent()->activationDegree(conjunction, disjunction, context);
+    }
+
+    void Rule::activate(scalar degree, const TNorm* activation, Context& context) const {
+        if (not isLoaded()) {
+            throw fl::Exception("[rule error] the following rule is not loaded: " + _text, FL_AT);
+        }
+        _consequent->modify(degree, activation, context);
+    }
+
     bool Rule::isLoaded() const {
         return _antecedent->isLoaded() and _consequent->isLoaded();
     }
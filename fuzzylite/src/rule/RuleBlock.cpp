@@ -92,6 +92,24 @@ namespace fl {
         }
     }
 
+    void RuleBlock::activate(Context& context) const {
+        FL_DBG("===================");
+        FL_DBG("ACTIVATING RULEBLOCK " << _name);
+        for (std::size_t i = 0; i < _rules.size(); ++i) {
+            Rule* rule = _rules.at(i);
+            if (rule->isLoaded()) {
+                scalar activationDegree = rule->activationDegree(_conjunction.get(),
+                        _disjunction.get(), context);
+                FL_DBG("[degree=" << Op::str(activationDegree) << "] " << rule->toString());
+                if (Op::isGt(activationDegree, 0.0)) {
+                    rule->activate(activationDegree, _activation.get(), context);
+                }
+            } else {
+                FL_DBG("Rule not loaded: " << rule->toString());
+            }
+        }
+    }
+
     void RuleBlock::unloadRules() const {
         for (std::size_t i = 0; i < _rules.size(); ++i) {
             _rules.at(i)->unload();
@@ -34,7 +34,8 @@ namespace fl {
 
     Accumulated::Accumulated(const std::string& name, scalar minimum, scalar maximum,
             SNorm* accumulation)
-    : Term(name), _minimum(minimum), _maximum(maximum), _accumulation(accumulation) {
+    : Term(name), _minimum(minimum), _maximum(maximum), _accumulation(accumulation),
+    _groupByTerm(false) {
     }
 
     Accumulated::Accumulated(const Accumulated& other) : Term(other) {
@@ -54,11 +55,15 @@ namespace fl {
 
     Accumulated::~Accumulated() {
         clear();
+        for (std::size_t i = 0; i < _pool.size(); ++i) {
+            delete _pool.at(i);
+        }
     }
 
     void Accumulated::copyFrom(const Accumulated& source) {
         _minimum = source._minimum;
         _maximum = source._maximum;
+        _groupByTerm = source._groupByTerm;
 
         if (source._accumulation.get())
             _accumulation.reset(source._accumulation->clone());
@@ -85,6 +90,60 @@ namespace fl {
         return mu;
     }
 
+    void Accumulated::membership(const scalar* x, scalar* y, std::size_t n) const {
+        if (n == 0) return;
+        if (not (_terms.empty() or _accumulation.get())) { //Exception for IntegralDefuzzifiers
+            throw fl::Exception("[accumulation error] "
+                    "accumulation operator needed to accumulate " + toString(), FL_AT);
+        }
+        //the memberships of each term are computed one block at a time, without allocating
+        const std::size_t blockSize = 128;
+        scalar buffer[blockSize];
+        std::fill(y, y + n, scalar(0.0));
+        for (std::size_t i = 0; i < n; i += blockSize) {
+            const std::size_t size = std::min(n - i, blockSize);
+            for (std::size_t t = 0; t < _terms.size(); ++t) {
+                _terms.at(t)->membership(x + i, buffer, size);
+                _accumulation->compute(y + i, buffer, y + i, size);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (x[i] != x[i]) y[i] = fl::nan;
+        }
+    }
+
+    void Accumulated::membership(const scalar* x, scalar* y, std::size_t n,
+            std::vector<scalar>& buffer) const {
+        if (n == 0) return;
+        if (not (_terms.empty() or _accumulation.get())) { //Exception for IntegralDefuzzifiers
+            throw fl::Exception("[accumulation error] "
+                    "accumulation operator needed to accumulate " + toString(), FL_AT);
+        }
+        std::fill(y, y + n, scalar(0.0));
+        if (not _terms.empty() and buffer.size() < n) buffer.resize(n);
+        for (std::size_t t = 0; t < _terms.size(); ++t) {
+            _terms.at(t)->membership(x, &buffer[0], n);
+            _accumulation->compute(y, &buffer[0], y, n);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (x[i] != x[i]) y[i] = fl::nan;
+        }
+    }
+
+    void Accumulated::support(scalar& minimum, scalar& maximum) const {
+        minimum = fl::inf;
+        maximum = -fl::inf;
+        scalar termMinimum, termMaximum;
+        for (std::size_t i = 0; i < _terms.size(); ++i) {
+            _terms.at(i)->support(termMinimum, termMaximum);
+            if (termMinimum > termMaximum) continue;
+            if (Op::isNaN(termMinimum)) termMinimum = -fl::inf;
+            if (Op::isNaN(termMaximum)) termMaximum = fl::inf;
+            minimum = Op::min(minimum, termMinimum);
+            maximum = Op::max(maximum, termMaximum);
+        }
+    }
+
     scalar Accumulated::activationDegree(const Term* forTerm) const {
         scalar result = 0.0;
         for (std::size_t i = 0; i < _terms.size(); ++i) {
@@ -162,13 +221,44 @@ namespace fl {
         return this->_accumulation.get();
     }
 
+    void Accumulated::setGroupByTerm(bool groupByTerm) {
+        this->_groupByTerm = groupByTerm;
+    }
+
+    bool Accumulated::isGroupedByTerm() const {
+        return this->_groupByTerm;
+    }
+
     /**
      * Operations for std::vector _terms
      */
 
 
-    void Accumulated::addTerm(const Term* term, scalar degree, const TNorm* activation) {
-        this->_terms.push_back(new Activated(term, degree, activation));
+    Activated* Accumulated::addTerm(const Term* term, scalar degree, const TNorm* activation) {
+        //T(m, max(a, b)) = max(T(m, a), T(m, b)) for every activation T, unlike other accumulations
+        if (_groupByTerm and _accumulation.get() and _accumulation->kernel() == Norm::MaximumKernel) {
+            for (std::size_t i = 0; i < _terms.size(); ++i) {
+                Activated* activated = _terms.at(i);
+                if (activated->getTerm() == term and activated->getActivation() == activation) {
+                    activated->setDegree(_accumulation->compute(activated->getDegree(), degree));
+                    return activated;
+                }
+            }
+        }
+        Activated* activated;
+        if (_pool.empty()) {
+            activated = new Activated(term, degree, activation);
+        } else {
+            activated = _pool.back();
+            _pool.pop_back();
+            activated->setTerm(term);
+            activated->setDegree(degree);
+            activated->setActivation(activation);
+            activated->setContext(fl::null);
+            activated->setTermIndex(-1);
+        }
+        this->_terms.push_back(activated);
+        return activated;
     }
 
     void Accumulated::addTerm(Activated* term) {
@@ -182,12 +272,20 @@ namespace fl {
     }
 
     void Accumulated::clear() {
-        for (std::size_t i = 0; i < _terms.size(); ++i) {
-            delete _terms.at(i);
-        }
+        _pool.insert(_pool.end(), _terms.begin(), _terms.end());
         _terms.clear();
     }
 
+    void Accumulated::reserve(int numberOfTerms) {
+        std::size_t size = std::max(0, numberOfTerms);
+        _terms.reserve(size);
+        _pool.reserve(size);
+        while (_terms.size() + _pool.size() < size) {
+            _pool.push_back(new Activated);
+        }
+        _pool.reserve(_terms.size() + _pool.size());
+    }
+
     Activated* Accumulated::getTerm(int index) const {
         return this->_terms.at(index);
     }
@@ -30,8 +30,8 @@
 namespace fl {
 
     Activated::Activated(const Term* term, scalar degree, const TNorm* activation)
-    : Term(""), _term(term), _degree(degree), _activation(activation) {
-        if (term) this->_name = term->getName();
+    : Term(""), _term(term), _degree(degree), _activation(activation), _context(fl::null),
+    _termIndex(-1) {
     }
 
     Activated::~Activated() {
@@ -41,13 +41,67 @@ namespace fl {
         return "Activated";
     }
 
+    std::string Activated::getName() const {
+        return _term ? _term->getName() : this->_name;
+    }
+
     scalar Activated::membership(scalar x) const {
         if (fl::Op::isNaN(x)) return fl::nan;
         if (not _activation) throw fl::Exception("[activation error] "
                 "activation operator needed to activate " + _term->toString(), FL_AT);
+        if (_context) return _activation->compute(this->_term->membership(x, *_context), _degree);
         return _activation->compute(this->_term->membership(x), _degree);
     }
 
+    scalar Activated::membership(scalar x, const Context& context) const {
+        if (fl::Op::isNaN(x)) return fl::nan;
+        if (not _activation) throw fl::Exception("[activation error] "
+                "activation operator needed to activate " + _term->toString(), FL_AT);
+        return _activation->compute(this->_term->membership(x, context), _degree);
+    }
+
+    void Activated::membership(const scalar* x, scalar* y, std::size_t n) const {
+        if (_context) {
+            membership(x, y, n, *_context);
+            return;
+        }
+        if (n == 0) return;
+        if (not _activation) throw fl::Exception("[activation error] "
+                "activation operator needed to activate " + _term->toString(), FL_AT);
+        this->_term->membership(x, y, n);
+        activate(x, y, n);
+    }
+
+    void Activated::membership(const scalar* x, scalar* y, std::size_t n, const Context& context) const {
+        if (n == 0) return;
+        if (not _activation) throw fl::Exception("[activation error] "
+                "activation operator needed to activate " + _term->toString(), FL_AT);
+        this->_term->membership(x, y, n, context);
+        activate(x, y, n);
+    }
+
+    void Activated::activate(const scalar* x, scalar* y, std::size_t n) const {
+        const std::size_t blockSize = 128;
+        scalar degrees[blockSize];
+        std::fill(degrees, degrees + std::min(n, blockSize), _degree);
+        for (std::size_t i = 0; i < n; i += blockSize) {
+            _activation->compute(y + i, degrees, y + i, std::min(n - i, blockSize));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (x[i] != x[i]) y[i] = fl::nan;
+        }
+    }
+
+    void Activated::support(scalar& minimum, scalar& maximum) const {
+        //every activation operator yields zero for a zero degree
+        if (_term and _degree != 0.0) {
+            _term->support(minimum, maximum);
+        } else {
+            minimum = fl::inf;
+            maximum = -fl::inf;
+        }
+    }
+
     std::string Activated::parameters() const {
         FllExporter exporter;
         std::ostringstream ss;
@@ -93,8 +147,27 @@ namespace fl {
         return this->_activation;
     }
 
+    void Activated::setContext(Context* context) {
+        this->_context = context;
+    }
+
+    Context* Activated::getContext() const {
+        return this->_context;
+    }
+
+    void Activated::setTermIndex(int termIndex) {
+        this->_termIndex = termIndex;
+    }
+
+    int Activated::getTermIndex() const {
+        return this->_termIndex;
+    }
+
     Activated* Activated::clone() const {
-        return new Activated(*this);
+        //the context of the evaluation does not apply to the clone
+        Activated* result = new Activated(*this);
+        result->_context = fl::null;
+        return result;
     }
 
 }
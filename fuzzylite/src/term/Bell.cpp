@@ -42,6 +42,16 @@ namespace fl {
         return _height * (1.0 / (1.0 + std::pow(std::abs((x - _center) / _width), 2 * _slope)));
     }
 
+    void Bell::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar center = _center, width = _width, h = _height;
+        const scalar exponent = 2 * _slope;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = h * (1.0 / (1.0 + std::pow(std::abs((xi - center) / width), exponent)));
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
     std::string Bell::parameters() const {
         return Op::join(3, " ", _center, _width, _slope) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
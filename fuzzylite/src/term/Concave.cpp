@@ -53,6 +53,32 @@ namespace fl {
         return _height * 1.0;
     }
 
+    void Concave::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar inflection = _inflection, end = _end, h = _height;
+        const bool increasing = fl::Op::isLE(_inflection, _end);
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = h * 1.0;
+            if (increasing) {
+                if (xi < end and not (end - xi < eps)) mu = h * (end - inflection) / (2 * end - inflection - xi);
+            } else {
+                if (xi > end and not (xi - end < eps)) mu = h * (inflection - end) / (inflection - 2 * end + xi);
+            }
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    bool Concave::isMonotonic() const {
+        return true;
+    }
+
+    scalar Concave::tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const {
+        (void) minimum;
+        (void) maximum;
+        return (_inflection - _end) / membership(activationDegree) + 2 * _end - _inflection;
+    }
+
     std::string Concave::parameters() const {
         return Op::join(2, " ", _inflection, _end) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -42,6 +42,15 @@ namespace fl {
         return this->_value;
     }
 
+    void Constant::membership(const scalar* x, scalar* y, std::size_t n) const {
+        (void) x;
+        std::fill(y, y + n, this->_value);
+    }
+
+    bool Constant::isTakagiSugeno() const {
+        return true;
+    }
+
     std::string Constant::parameters() const {
         return Op::str(_value);
     }
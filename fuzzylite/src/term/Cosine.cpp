@@ -70,6 +70,26 @@ namespace fl {
         return _height * (0.5 * (1.0 + std::cos(2.0 / _width * pi * (x - _center))));
     }
 
+    void Cosine::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar center = _center, h = _height;
+        const scalar left = _center - _width / 2.0, right = _center + _width / 2.0;
+        const scalar pi = 4.0 * std::atan(1.0);
+        const scalar frequency = 2.0 / _width * pi;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if ((xi < left and not (left - xi < eps)) or (xi > right and not (xi - right < eps))) mu = h * 0.0;
+            else mu = h * (0.5 * (1.0 + std::cos(frequency * (xi - center))));
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void Cosine::support(scalar& minimum, scalar& maximum) const {
+        minimum = _center - _width / 2.0;
+        maximum = _center + _width / 2.0;
+    }
+
     void Cosine::setCenter(scalar center) {
         this->_center = center;
     }
@@ -24,12 +24,14 @@
 
 #include "fl/term/Discrete.h"
 
+#include <cmath>
 #include <cstdarg>
 
 namespace fl {
 
     Discrete::Discrete(const std::string& name, const std::vector<Pair>& xy, scalar height)
-    : Term(name, height), _xy(xy) {
+    : Term(name, height), _xy(xy), _sorted(false), _uniform(false) {
+        updateIndex();
     }
 
     Discrete::~Discrete() {
@@ -55,6 +57,8 @@ namespace fl {
         if (fl::Op::isLE(_x_, _xy.front().first)) return _height * _xy.front().second;
         if (fl::Op::isGE(_x_, _xy.back().first)) return _height * _xy.back().second;
 
+        if (_sorted) return _height * interpolate(_x_, upperBound(_x_, 0));
+
         int lower = -1, upper = -1;
 
         for (std::size_t i = 0; i < _xy.size(); ++i) {
@@ -76,6 +80,100 @@ namespace fl {
                 _xy.at(lower).second, _xy.at(upper).second);
     }
 
+    void Discrete::membership(const scalar* x, scalar* y, std::size_t n) const {
+        if (not _sorted) {
+            Term::membership(x, y, n);
+            return;
+        }
+        //the upper bound of the previous value is the hint for the next one,
+        //which finds it in constant time when sweeping x in order
+        std::size_t upper = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            if (fl::Op::isNaN(xi)) {
+                y[i] = fl::nan;
+            } else if (fl::Op::isLE(xi, _xy.front().first)) {
+                y[i] = _height * _xy.front().second;
+            } else if (fl::Op::isGE(xi, _xy.back().first)) {
+                y[i] = _height * _xy.back().second;
+            } else {
+                upper = upperBound(xi, upper);
+                y[i] = _height * interpolate(xi, upper);
+            }
+        }
+    }
+
+    std::size_t Discrete::upperBound(scalar x, std::size_t hint) const {
+        const std::size_t size = _xy.size();
+        for (std::size_t i = hint; i > 0 and i < size and i <= hint + 1; ++i) {
+            if (_xy[i - 1].first <= x and x < _xy[i].first) return i;
+        }
+        if (_uniform) {
+            const scalar step = (_xy.back().first - _xy.front().first) / (size - 1);
+            std::size_t upper = 1 + std::size_t(Op::bound(std::floor((x - _xy.front().first) / step),
+                    scalar(0.0), scalar(size - 1)));
+            while (upper < size and _xy[upper].first <= x) ++upper;
+            while (upper > 0 and _xy[upper - 1].first > x) --upper;
+            return upper;
+        }
+        std::size_t first = 0, count = size;
+        while (count > 0) {
+            std::size_t step = count / 2;
+            if (_xy[first + step].first <= x) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+
+    scalar Discrete::interpolate(scalar x, std::size_t upper) const {
+        //same as the linear scan in membership, starting from the first pair
+        //that is not less than x, as the pairs before it are all less than x
+        std::size_t start = upper;
+        while (start > 0 and not Op::isLt(_xy[start - 1].first, x)) --start;
+        int lower = int(start) - 1, greater = -1;
+        for (std::size_t i = start; i < _xy.size(); ++i) {
+            if (Op::isEq(_xy[i].first, x)) return _xy[i].second;
+            if (Op::isLt(_xy[i].first, x)) {
+                lower = i;
+            }
+            if (Op::isGt(_xy[i].first, x)) {
+                greater = i;
+                break;
+            }
+        }
+        if (greater < 0) greater = _xy.size() - 1;
+        if (lower < 0) lower = 0;
+        return Op::scale(x, _xy.at(lower).first, _xy.at(greater).first,
+                _xy.at(lower).second, _xy.at(greater).second);
+    }
+
+    void Discrete::updateIndex() {
+        _sorted = not _xy.empty();
+        for (std::size_t i = 0; _sorted and i < _xy.size(); ++i) {
+            _sorted = not Op::isNaN(_xy[i].first)
+                    and (i == 0 or _xy[i - 1].first <= _xy[i].first);
+        }
+        _uniform = _sorted and _xy.size() > 1 and _xy.front().first < _xy.back().first;
+        if (_uniform) {
+            const scalar step = (_xy.back().first - _xy.front().first) / (_xy.size() - 1);
+            for (std::size_t i = 0; _uniform and i < _xy.size(); ++i) {
+                _uniform = std::fabs(_xy[i].first - (_xy.front().first + i * step)) < 0.5 * step;
+            }
+        }
+    }
+
+    bool Discrete::isSorted() const {
+        return this->_sorted;
+    }
+
+    bool Discrete::isUniform() const {
+        return this->_uniform;
+    }
+
     std::string Discrete::parameters() const {
         std::ostringstream ss;
         for (std::size_t i = 0; i < _xy.size(); ++i) {
@@ -100,6 +198,7 @@ namespace fl {
             values.pop_back();
         }
         this->_xy = toPairs(values);
+        updateIndex();
     }
 
     template <typename T>
@@ -132,6 +231,7 @@ namespace fl {
 
     void Discrete::setXY(const std::vector<Pair>& pairs) {
         this->_xy = pairs;
+        updateIndex();
     }
 
     const std::vector<Discrete::Pair>& Discrete::xy() const {
@@ -139,6 +239,8 @@ namespace fl {
     }
 
     std::vector<Discrete::Pair>& Discrete::xy() {
+        this->_sorted = false;
+        this->_uniform = false;
         return this->_xy;
     }
 
@@ -147,6 +249,8 @@ namespace fl {
     }
 
     Discrete::Pair& Discrete::xy(int index) {
+        this->_sorted = false;
+        this->_uniform = false;
         return this->_xy.at(index);
     }
 
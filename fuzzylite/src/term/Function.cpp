@@ -24,6 +24,7 @@
 
 #include "fl/term/Function.h"
 
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/factory/FactoryManager.h"
 #include "fl/factory/FunctionFactory.h"
@@ -31,8 +32,10 @@
 #include "fl/variable/InputVariable.h"
 #include "fl/variable/OutputVariable.h"
 
+#include <algorithm>
 #include <cctype>
 #include <functional>
+#include <iomanip>
 #include <queue>
 #include <signal.h>
 #include <stack>
@@ -249,11 +252,15 @@ namespace fl {
      **********************************/
     Function::Function(const std::string& name,
             const std::string& formula, const Engine* engine)
-    : Term(name), _root(fl::null), _formula(formula), _engine(engine) {
+    : Term(name), _root(fl::null), _formula(formula), _engine(engine),
+    _stackSize(0), _registers(0), _monotonic(false) {
     }
 
     Function::Function(const Function& other) : Term(other),
-    _root(fl::null), _formula(other._formula), _engine(other._engine) {
+    _root(fl::null), _formula(other._formula), _engine(other._engine),
+    _instructions(other._instructions), _stackSize(other._stackSize), _registers(other._registers),
+    _compiledInputs(other._compiledInputs), _compiledOutputs(other._compiledOutputs),
+    _monotonic(other._monotonic) {
         if (other._root.get()) _root.reset(other._root->clone());
         variables = other.variables;
     }
@@ -267,6 +274,12 @@ namespace fl {
             _engine = other._engine;
             if (other._root.get()) _root.reset(other._root->clone());
             variables = other.variables;
+            _instructions = other._instructions;
+            _stackSize = other._stackSize;
+            _registers = other._registers;
+            _compiledInputs = other._compiledInputs;
+            _compiledOutputs = other._compiledOutputs;
+            _monotonic = other._monotonic;
         }
         return *this;
     }
@@ -278,10 +291,36 @@ namespace fl {
         return "Function";
     }
 
+    void Function::setMonotonic(bool monotonic) {
+        this->_monotonic = monotonic;
+    }
+
+    bool Function::isMonotonic() const {
+        return this->_monotonic;
+    }
+
+    bool Function::isTakagiSugeno() const {
+        return not this->_monotonic;
+    }
+
+    bool Function::dependsOnVariables() const {
+        return true;
+    }
+
+    bool Function::dependsOnlyOnInputs() const {
+        if (not isCompiled()) return false;
+        for (std::size_t i = 0; i < _instructions.size(); ++i) {
+            Instruction::Opcode opcode = _instructions[i].opcode;
+            if (opcode == Instruction::ValueOfX or opcode == Instruction::OutputValue) return false;
+        }
+        return true;
+    }
+
     scalar Function::membership(scalar x) const {
         if (not this->_root.get()) {
             throw fl::Exception("[function error] function <" + _formula + "> not loaded.", FL_AT);
         }
+        if (isCompiled()) return execute(x, fl::null);
         if (this->_engine) {
             for (int i = 0; i < this->_engine->numberOfInputVariables(); ++i) {
                 InputVariable* input = this->_engine->getInputVariable(i);
@@ -296,6 +335,103 @@ namespace fl {
         return this->evaluate(&this->variables);
     }
 
+    scalar Function::membership(scalar x, const Context& context) const {
+        if (not this->_root.get()) {
+            throw fl::Exception("[function error] function <" + _formula + "> not loaded.", FL_AT);
+        }
+        if (isCompiled()) return execute(x, &context);
+        return interpret(this->_root.get(), x, context);
+    }
+
+    scalar Function::interpret(const Node* node, scalar x, const Context& context) const {
+        const Element* element = node->element.get();
+        if (element and element->unary) {
+            return element->unary(interpret(node->left.get(), x, context));
+        }
+        if (element and element->binary) {
+            return element->binary(interpret(node->right.get(), x, context),
+                    interpret(node->left.get(), x, context));
+        }
+        if (element or node->variable.empty()) {
+            return node->evaluate(&this->variables); //constants, or elements without arity
+        }
+        //Same precedence as when the values are mapped: x, outputs, inputs, others
+        if (node->variable == "x") return x;
+        if (this->_engine) {
+            for (int i = 0; i < this->_engine->numberOfOutputVariables(); ++i) {
+                if (this->_engine->getOutputVariable(i)->getName() == node->variable)
+                    return context.getOutputValue(i);
+            }
+            for (int i = 0; i < this->_engine->numberOfInputVariables(); ++i) {
+                if (this->_engine->getInputVariable(i)->getName() == node->variable)
+                    return context.getInputValue(i);
+            }
+        }
+        return node->evaluate(&this->variables);
+    }
+
+    scalar Function::execute(scalar x, const Context* context) const {
+        scalar buffer[16] = {0.0};
+        std::vector<scalar> heapBuffer;
+        scalar* stack = buffer;
+        if (_stackSize > 16) {
+            heapBuffer.resize(_stackSize);
+            stack = &heapBuffer[0];
+        }
+        std::size_t top = 0;
+        scalar registerBuffer[16] = {0.0};
+        std::vector<scalar> heapRegisters;
+        scalar* registers = registerBuffer;
+        if (_registers > 16) {
+            heapRegisters.resize(_registers);
+            registers = &heapRegisters[0];
+        }
+
+        for (std::size_t i = 0; i < _instructions.size(); ++i) {
+            const Instruction& instruction = _instructions[i];
+            switch (instruction.opcode) {
+                case Instruction::StoreResult:
+                    registers[instruction.index] = stack[top - 1];
+                    break;
+                case Instruction::LoadResult:
+                    stack[top++] = registers[instruction.index];
+                    break;
+                case Instruction::UnaryElement:
+                    stack[top - 1] = instruction.unary(stack[top - 1]);
+                    break;
+                case Instruction::BinaryElement:
+                    --top;
+                    stack[top - 1] = instruction.binary(stack[top - 1], stack[top]);
+                    break;
+                case Instruction::Constant:
+                    stack[top++] = instruction.value;
+                    break;
+                case Instruction::ValueOfX:
+                    stack[top++] = x;
+                    break;
+                case Instruction::InputValue:
+                    stack[top++] = context
+                            ? context->inputValues()[instruction.index]
+                            : _engine->getInputVariable(instruction.index)->getInputValue();
+                    break;
+                case Instruction::OutputValue:
+                    stack[top++] = context
+                            ? context->outputValues()[instruction.index]
+                            : _engine->getOutputVariable(instruction.index)->getOutputValue();
+                    break;
+                case Instruction::MappedValue:
+                {
+                    std::map<std::string, scalar>::const_iterator it = variables.find(instruction.variable);
+                    if (it == variables.end()) throw fl::Exception("[function error] "
+                            "unknown variable <" + instruction.variable + ">", FL_AT);
+                    stack[top++] = it->second;
+                    break;
+                }
+            }
+        }
+        return stack[0];
+    }
+
     scalar Function::evaluate(const std::map<std::string, scalar>* localVariables) const {
         if (not this->_root.get())
             throw fl::Exception("[function error] evaluation failed because the function is not loaded", FL_AT);
@@ -304,6 +440,138 @@ namespace fl {
         return this->_root->evaluate(&this->variables);
     }
 
+    void Function::membership(const scalar* x, scalar* y, std::size_t n) const {
+        evaluate(x, fl::null, fl::null, y, n);
+    }
+
+    void Function::membership(const scalar* x, scalar* y, std::size_t n, const Context& context) const {
+        if (not this->_root.get()) {
+            throw fl::Exception("[function error] function <" + _formula + "> not loaded.", FL_AT);
+        }
+        if (isCompiled()) {
+            execute(x, fl::null, fl::null, y, n, &context);
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = interpret(this->_root.get(), x[i], context);
+        }
+    }
+
+    void Function::evaluate(const scalar* x, const scalar* const* inputValues,
+            const scalar* const* outputValues, scalar* y, std::size_t n) const {
+        if (not this->_root.get()) {
+            throw fl::Exception("[function error] function <" + _formula + "> not loaded.", FL_AT);
+        }
+        if (not isCompiled()) {
+            std::map<std::string, scalar> localVariables(this->variables);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (this->_engine) {
+                    for (int v = 0; v < this->_engine->numberOfInputVariables(); ++v) {
+                        InputVariable* input = this->_engine->getInputVariable(v);
+                        localVariables[input->getName()] =
+                                inputValues ? inputValues[v][i] : input->getInputValue();
+                    }
+                    for (int v = 0; v < this->_engine->numberOfOutputVariables(); ++v) {
+                        OutputVariable* output = this->_engine->getOutputVariable(v);
+                        localVariables[output->getName()] =
+                                outputValues ? outputValues[v][i] : output->getOutputValue();
+                    }
+                }
+                localVariables["x"] = x[i];
+                y[i] = this->evaluate(&localVariables);
+            }
+            return;
+        }
+        execute(x, inputValues, outputValues, y, n, fl::null);
+    }
+
+    void Function::execute(const scalar* x, const scalar* const* inputValues,
+            const scalar* const* outputValues, scalar* y, std::size_t n,
+            const Context* context) const {
+        //Each slot of the stack and each register holds a column of a block of rows
+        const std::size_t block = 128;
+        std::vector<scalar> buffer((_stackSize + _registers) * block);
+        scalar* stack = buffer.empty() ? fl::null : &buffer[0];
+        scalar* registers = stack + _stackSize * block;
+
+        for (std::size_t start = 0; start < n; start += block) {
+            const std::size_t rows = std::min(block, n - start);
+            std::size_t top = 0;
+            for (std::size_t i = 0; i < _instructions.size(); ++i) {
+                const Instruction& instruction = _instructions[i];
+                if (instruction.opcode == Instruction::UnaryElement) {
+                    scalar* a = stack + (top - 1) * block;
+                    if (instruction.unary == &(fl::Op::negate)) {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = -a[j];
+                    } else {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = instruction.unary(a[j]);
+                    }
+                    continue;
+                }
+                if (instruction.opcode == Instruction::BinaryElement) {
+                    --top;
+                    scalar* a = stack + (top - 1) * block;
+                    const scalar* b = stack + top * block;
+                    if (instruction.binary == &(fl::Op::add)) {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = a[j] + b[j];
+                    } else if (instruction.binary == &(fl::Op::subtract)) {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = a[j] - b[j];
+                    } else if (instruction.binary == &(fl::Op::multiply)) {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = a[j] * b[j];
+                    } else if (instruction.binary == &(fl::Op::divide)) {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = a[j] / b[j];
+                    } else {
+                        for (std::size_t j = 0; j < rows; ++j) a[j] = instruction.binary(a[j], b[j]);
+                    }
+                    continue;
+                }
+                if (instruction.opcode == Instruction::StoreResult) {
+                    const scalar* a = stack + (top - 1) * block;
+                    std::copy(a, a + rows, registers + instruction.index * block);
+                    continue;
+                }
+
+                scalar* column = stack + (top++) * block;
+                const scalar* source = fl::null;
+                scalar value = fl::nan;
+                switch (instruction.opcode) {
+                    case Instruction::Constant:
+                        value = instruction.value;
+                        break;
+                    case Instruction::ValueOfX:
+                        source = x + start;
+                        break;
+                    case Instruction::InputValue:
+                        if (inputValues) source = inputValues[instruction.index] + start;
+                        else if (context) value = context->getInputValue(instruction.index);
+                        else value = _engine->getInputVariable(instruction.index)->getInputValue();
+                        break;
+                    case Instruction::OutputValue:
+                        if (outputValues) source = outputValues[instruction.index] + start;
+                        else if (context) value = context->getOutputValue(instruction.index);
+                        else value = _engine->getOutputVariable(instruction.index)->getOutputValue();
+                        break;
+                    case Instruction::LoadResult:
+                        source = registers + instruction.index * block;
+                        break;
+                    case Instruction::MappedValue:
+                    {
+                        std::map<std::string, scalar>::const_iterator it = variables.find(instruction.variable);
+                        if (it == variables.end()) throw fl::Exception("[function error] "
+                                "unknown variable <" + instruction.variable + ">", FL_AT);
+                        value = it->second;
+                        break;
+                    }
+                    default:
+                        break;
+                }
+                if (source) std::copy(source, source + rows, column);
+                else std::fill(column, column + rows, value);
+            }
+            std::copy(stack, stack + rows, y + start);
+        }
+    }
+
     std::string Function::parameters() const {
         return _formula;
     }
@@ -326,6 +594,9 @@ namespace fl {
     void Function::unload() {
         this->_root.reset(fl::null);
         this->variables.clear();
+        this->_instructions.clear();
+        this->_stackSize = 0;
+        this->_registers = 0;
     }
 
     void Function::load() {
@@ -342,9 +613,156 @@ namespace fl {
         this->_formula = formula;
         this->_engine = engine;
         this->_root.reset(parse(formula));
+        compile();
         membership(0.0); //make sure function evaluates without throwing exception.
     }
 
+    Function::Instruction::Instruction(Opcode opcode)
+    : opcode(opcode), value(fl::nan), index(-1), variable(""), unary(fl::null), binary(fl::null) {
+    }
+
+    void Function::compile() {
+        std::vector<Instruction> instructions;
+        std::map<std::string, int> occurrences;
+        std::map<std::string, int> registers;
+        if (_root.get()) {
+            subtreeKey(_root.get(), &occurrences);
+            compile(_root.get(), instructions, occurrences, registers);
+        }
+        std::size_t size = 0;
+        _stackSize = 0;
+        int operations = 0, compiledOperations = 0;
+        for (std::map<std::string, int>::const_iterator it = occurrences.begin();
+                it != occurrences.end(); ++it) {
+            operations += it->second;
+        }
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            Instruction::Opcode opcode = instructions.at(i).opcode;
+            if (opcode == Instruction::UnaryElement or opcode == Instruction::BinaryElement) {
+                ++compiledOperations;
+            }
+            if (opcode == Instruction::BinaryElement) --size;
+            else if (opcode != Instruction::UnaryElement and opcode != Instruction::StoreResult) ++size;
+            _stackSize = std::max(_stackSize, size);
+        }
+        _instructions.swap(instructions);
+        _registers = registers.size();
+        _compiledInputs.clear();
+        _compiledOutputs.clear();
+        if (_engine) {
+            _compiledInputs = _engine->inputVariables();
+            _compiledOutputs = _engine->outputVariables();
+        }
+        FL_DBG("[function] formula <" << _formula << "> compiled from " << operations
+                << " to " << compiledOperations << " operations");
+    }
+
+    std::string Function::subtreeKey(const Node* node, std::map<std::string, int>* occurrences) const {
+        std::ostringstream ss;
+        if (node->element.get()) {
+            ss << "(" << node->element->name;
+            if (node->right.get()) ss << " " << subtreeKey(node->right.get(), occurrences);
+            if (node->left.get()) ss << " " << subtreeKey(node->left.get(), occurrences);
+            ss << ")";
+            if (occurrences) ++(*occurrences)[ss.str()];
+        } else if (not node->variable.empty()) {
+            ss << "$" << node->variable;
+        } else {
+            ss << "#" << std::setprecision(17) << node->value;
+        }
+        return ss.str();
+    }
+
+    void Function::compile(const Node* node, std::vector<Instruction>& instructions,
+            std::map<std::string, int>& occurrences, std::map<std::string, int>& registers) const {
+        Instruction instruction;
+        if (node->element.get()) {
+            const Element* element = node->element.get();
+            std::string key = subtreeKey(node);
+            if (key.find('$') == std::string::npos) { //no variables, fold into a constant
+                instruction.opcode = Instruction::Constant;
+                instruction.value = node->evaluate();
+                instructions.push_back(instruction);
+                return;
+            }
+            bool isCommon = occurrences[key] > 1;
+            if (isCommon and registers.find(key) != registers.end()) {
+                instruction.opcode = Instruction::LoadResult;
+                instruction.index = registers[key];
+                instructions.push_back(instruction);
+                return;
+            }
+            if (element->unary) {
+                compile(node->left.get(), instructions, occurrences, registers);
+                instruction.opcode = Instruction::UnaryElement;
+                instruction.unary = element->unary;
+            } else if (element->binary) {
+                compile(node->right.get(), instructions, occurrences, registers);
+                compile(node->left.get(), instructions, occurrences, registers);
+                instruction.opcode = Instruction::BinaryElement;
+                instruction.binary = element->binary;
+            } else {
+                std::ostringstream ex;
+                ex << "[function error] arity <" << element->arity << "> of "
+                        << (element->isOperator() ? "operator" : "function") <<
+                        " <" << element->name << "> is fl::null";
+                throw fl::Exception(ex.str(), FL_AT);
+            }
+            if (isCommon) {
+                instructions.push_back(instruction);
+                instruction = Instruction(Instruction::StoreResult);
+                instruction.index = registers.size();
+                registers[key] = instruction.index;
+            }
+        } else if (not node->variable.empty()) {
+            instruction.variable = node->variable;
+            //Same precedence as when the values are mapped: x, outputs, inputs, others
+            if (node->variable == "x") {
+                instruction.opcode = Instruction::ValueOfX;
+            } else if (_engine) {
+                for (int i = 0; i < _engine->numberOfOutputVariables(); ++i) {
+                    if (_engine->getOutputVariable(i)->getName() == node->variable) {
+                        instruction.opcode = Instruction::OutputValue;
+                        instruction.index = i;
+                    }
+                }
+                for (int i = 0; i < _engine->numberOfInputVariables()
+                        and instruction.opcode != Instruction::OutputValue; ++i) {
+                    if (_engine->getInputVariable(i)->getName() == node->variable) {
+                        instruction.opcode = Instruction::InputValue;
+                        instruction.index = i;
+                    }
+                }
+            }
+            if (instruction.index < 0 and instruction.opcode != Instruction::ValueOfX) {
+                instruction.opcode = Instruction::MappedValue;
+            }
+        } else {
+            instruction.opcode = Instruction::Constant;
+            instruction.value = node->value;
+        }
+        instructions.push_back(instruction);
+    }
+
+    bool Function::isCompiled() const {
+        if (_instructions.empty()) return false;
+        if (not _engine) return true;
+        if (not (_engine->inputVariables() == _compiledInputs
+                and _engine->outputVariables() == _compiledOutputs)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < _instructions.size(); ++i) {
+            const Instruction& instruction = _instructions[i];
+            if ((instruction.opcode == Instruction::InputValue
+                    and _compiledInputs[instruction.index]->getName() != instruction.variable)
+                    or (instruction.opcode == Instruction::OutputValue
+                    and _compiledOutputs[instruction.index]->getName() != instruction.variable)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void Function::setFormula(const std::string& formula) {
         this->_formula = formula;
     }
@@ -355,6 +773,7 @@ namespace fl {
 
     void Function::setEngine(const Engine* engine) {
         this->_engine = engine;
+        if (isLoaded()) compile();
     }
 
     const Engine* Function::getEngine() const {
@@ -365,6 +784,10 @@ namespace fl {
         return this->_root.get();
     }
 
+    const std::vector<Function::Instruction>& Function::instructions() const {
+        return this->_instructions;
+    }
+
     Function* Function::clone() const {
         return new Function(*this);
     }
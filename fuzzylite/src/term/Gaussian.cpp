@@ -43,6 +43,16 @@ namespace fl {
         return _height * std::exp((-(x - _mean) * (x - _mean)) / (2 * _standardDeviation * _standardDeviation));
     }
 
+    void Gaussian::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar mean = _mean, h = _height;
+        const scalar variance2 = 2 * _standardDeviation * _standardDeviation;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = h * std::exp((-(xi - mean) * (xi - mean)) / variance2);
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
     std::string Gaussian::parameters() const {
         return Op::join(2, " ", _mean, _standardDeviation) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -53,6 +53,22 @@ namespace fl {
         return _height * a * b;
     }
 
+    void GaussianProduct::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar meanA = _meanA, meanB = _meanB, h = _height;
+        const scalar varianceA2 = 2 * _standardDeviationA * _standardDeviationA;
+        const scalar varianceB2 = 2 * _standardDeviationB * _standardDeviationB;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            bool xLEa = (xi <= meanA or xi - meanA < eps);
+            scalar a = (1 - xLEa) + xLEa * std::exp((-(xi - meanA) * (xi - meanA)) / varianceA2);
+            bool xGEb = (xi >= meanB or meanB - xi < eps);
+            scalar b = (1 - xGEb) + xGEb * std::exp((-(xi - meanB) * (xi - meanB)) / varianceB2);
+            scalar mu = h * a * b;
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
     std::string GaussianProduct::parameters() const {
         return Op::join(4, " ", _meanA, _standardDeviationA, _meanB, _standardDeviationB) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -24,9 +24,11 @@
 
 #include "fl/term/Linear.h"
 
+#include "fl/Context.h"
 #include "fl/Engine.h"
 #include "fl/variable/InputVariable.h"
 
+#include <algorithm>
 #include <cstdarg>
 
 namespace fl {
@@ -49,17 +51,77 @@ namespace fl {
         if (not _engine) throw fl::Exception("[linear error] term <" + getName() + "> "
                 "is missing a reference to the engine", FL_AT);
 
+        const std::vector<InputVariable*>& inputVariables = _engine->inputVariables();
+        const std::size_t size = std::min(inputVariables.size(), _coefficients.size());
         scalar result = 0.0;
-        for (std::size_t i = 0; i < _engine->inputVariables().size(); ++i) {
-            if (i < _coefficients.size())
-                result += _coefficients.at(i) * _engine->inputVariables().at(i)->getInputValue();
+        for (std::size_t i = 0; i < size; ++i) {
+            result += _coefficients[i] * inputVariables[i]->getInputValue();
         }
-        if (_coefficients.size() > _engine->inputVariables().size()) {
+        if (_coefficients.size() > inputVariables.size()) {
             result += _coefficients.back();
         }
         return result;
     }
 
+    scalar Linear::membership(scalar x, const Context& context) const {
+        (void) x;
+        const std::vector<scalar>& inputValues = context.inputValues();
+        const std::size_t size = std::min(inputValues.size(), _coefficients.size());
+        scalar result = 0.0;
+        for (std::size_t i = 0; i < size; ++i) {
+            result += _coefficients[i] * inputValues[i];
+        }
+        if (_coefficients.size() > inputValues.size()) {
+            result += _coefficients.back();
+        }
+        return result;
+    }
+
+    void Linear::membership(const scalar* x, scalar* y, std::size_t n) const {
+        if (n > 0) std::fill(y, y + n, membership(x[0]));
+    }
+
+    void Linear::membership(const scalar* x, scalar* y, std::size_t n, const Context& context) const {
+        if (n > 0) std::fill(y, y + n, membership(x[0], context));
+    }
+
+    bool Linear::isTakagiSugeno() const {
+        return true;
+    }
+
+    bool Linear::dependsOnVariables() const {
+        return true;
+    }
+
+    void Linear::evaluate(const scalar* const* inputValues, scalar* y, std::size_t n) const {
+        if (not _engine) throw fl::Exception("[linear error] term <" + getName() + "> "
+                "is missing a reference to the engine", FL_AT);
+        const std::vector<InputVariable*>& inputVariables = _engine->inputVariables();
+        const std::size_t size = std::min(inputVariables.size(), _coefficients.size());
+        //each row adds the products in the same order as membership
+        std::fill(y, y + n, scalar(0.0));
+        for (std::size_t v = 0; v < size; ++v) {
+            const scalar coefficient = _coefficients[v];
+            if (inputValues) {
+                const scalar* column = inputValues[v];
+                for (std::size_t i = 0; i < n; ++i) {
+                    y[i] += coefficient * column[i];
+                }
+            } else {
+                const scalar product = coefficient * inputVariables[v]->getInputValue();
+                for (std::size_t i = 0; i < n; ++i) {
+                    y[i] += product;
+                }
+            }
+        }
+        if (_coefficients.size() > inputVariables.size()) {
+            const scalar constant = _coefficients.back();
+            for (std::size_t i = 0; i < n; ++i) {
+                y[i] += constant;
+            }
+        }
+    }
+
     void Linear::set(const std::vector<scalar>& coeffs, const Engine* engine) {
         setCoefficients(coeffs);
         setEngine(engine);
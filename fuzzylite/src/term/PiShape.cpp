@@ -67,6 +67,33 @@ namespace fl {
         return _height * 0.0;
     }
 
+    void PiShape::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar bottomLeft = _bottomLeft, topLeft = _topLeft;
+        const scalar topRight = _topRight, bottomRight = _bottomRight, h = _height;
+        const scalar a_b_ave = (_bottomLeft + _topLeft) / 2.0;
+        const scalar b_minus_a = _topLeft - _bottomLeft;
+        const scalar c_d_ave = (_topRight + _bottomRight) / 2.0;
+        const scalar d_minus_c = _bottomRight - _topRight;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if (xi <= bottomLeft or xi - bottomLeft < eps) mu = h * 0.0;
+            else if (xi <= a_b_ave or xi - a_b_ave < eps) mu = h * (2.0 * std::pow((xi - bottomLeft) / b_minus_a, 2));
+            else if (xi < topLeft and not (topLeft - xi < eps)) mu = h * (1.0 - 2.0 * std::pow((xi - topLeft) / b_minus_a, 2));
+            else if (xi <= topRight or xi - topRight < eps) mu = h * 1.0;
+            else if (xi <= c_d_ave or xi - c_d_ave < eps) mu = h * (1.0 - 2.0 * std::pow((xi - topRight) / d_minus_c, 2));
+            else if (xi < bottomRight and not (bottomRight - xi < eps)) mu = h * (2.0 * std::pow((xi - bottomRight) / d_minus_c, 2));
+            else mu = h * 0.0;
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void PiShape::support(scalar& minimum, scalar& maximum) const {
+        minimum = _bottomLeft;
+        maximum = _bottomRight;
+    }
+
     std::string PiShape::parameters() const {
         return Op::join(4, " ", _bottomLeft, _topLeft, _topRight, _bottomRight) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
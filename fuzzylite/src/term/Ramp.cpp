@@ -53,6 +53,52 @@ namespace fl {
         }
     }
 
+    void Ramp::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar start = _start, end = _end, h = _height;
+        const bool flat = Op::isEq(_start, _end);
+        const bool increasing = Op::isLt(_start, _end);
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if (flat) {
+                mu = h * 0.0;
+            } else if (increasing) {
+                if (xi <= start or xi - start < eps) mu = h * 0.0;
+                else if (xi >= end or end - xi < eps) mu = h * 1.0;
+                else mu = h * (xi - start) / (end - start);
+            } else {
+                if (xi >= start or start - xi < eps) mu = h * 0.0;
+                else if (xi <= end or xi - end < eps) mu = h * 1.0;
+                else mu = h * (start - xi) / (start - end);
+            }
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void Ramp::support(scalar& minimum, scalar& maximum) const {
+        if (Op::isEq(_start, _end)) {
+            minimum = fl::inf;
+            maximum = -fl::inf;
+        } else if (Op::isLt(_start, _end)) {
+            minimum = _start;
+            maximum = fl::inf;
+        } else {
+            minimum = -fl::inf;
+            maximum = _start;
+        }
+    }
+
+    bool Ramp::isMonotonic() const {
+        return true;
+    }
+
+    scalar Ramp::tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const {
+        (void) minimum;
+        (void) maximum;
+        return Op::scale(activationDegree, 0, 1, _start, _end);
+    }
+
     std::string Ramp::parameters() const {
         return Op::join(2, " ", _start, _end) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -44,6 +44,21 @@ namespace fl {
         return _height * 1.0;
     }
 
+    void Rectangle::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar start = _start, end = _end, h = _height;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = ((xi < start and not (start - xi < eps)) or (xi > end and not (xi - end < eps))) ? h * 0.0 : h * 1.0;
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void Rectangle::support(scalar& minimum, scalar& maximum) const {
+        minimum = _start;
+        maximum = _end;
+    }
+
     std::string Rectangle::parameters() const {
         return Op::join(2, " ", _start, _end) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -54,6 +54,44 @@ namespace fl {
         return _height * 1.0;
     }
 
+    void SShape::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar start = _start, end = _end, h = _height;
+        const scalar average = (_start + _end) / 2.0;
+        const scalar difference = _end - _start;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if (xi <= start or xi - start < eps) mu = h * 0.0;
+            else if (xi <= average or xi - average < eps) mu = h * (2.0 * std::pow((xi - start) / difference, 2));
+            else if (xi < end and not (end - xi < eps)) mu = h * (1.0 - 2.0 * std::pow((xi - end) / difference, 2));
+            else mu = h * 1.0;
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void SShape::support(scalar& minimum, scalar& maximum) const {
+        minimum = _start;
+        maximum = fl::inf;
+    }
+
+    bool SShape::isMonotonic() const {
+        return true;
+    }
+
+    scalar SShape::tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const {
+        (void) minimum;
+        (void) maximum;
+        scalar w = activationDegree;
+        scalar difference = _end - _start;
+        scalar a = _start + std::sqrt(w * difference * difference / 2.0);
+        scalar b = _end + std::sqrt(difference * difference * (w - 1.0) / -2.0);
+        if (std::fabs(w - membership(a)) < std::fabs(w - membership(b))) {
+            return a;
+        }
+        return b;
+    }
+
     std::string SShape::parameters() const {
         return Op::join(2, " ", _start, _end) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
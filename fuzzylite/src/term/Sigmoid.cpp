@@ -42,6 +42,30 @@ namespace fl {
         return _height * 1.0 / (1.0 + std::exp(-_slope * (x - _inflection)));
     }
 
+    void Sigmoid::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar slope = -_slope, inflection = _inflection, h = _height;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = h * 1.0 / (1.0 + std::exp(slope * (xi - inflection)));
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    bool Sigmoid::isMonotonic() const {
+        return true;
+    }
+
+    scalar Sigmoid::tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const {
+        scalar w = activationDegree;
+        if (Op::isEq(w, 1.0)) {
+            return Op::isGE(_slope, 0.0) ? maximum : minimum;
+        }
+        if (Op::isEq(w, 0.0)) {
+            return Op::isGE(_slope, 0.0) ? minimum : maximum;
+        }
+        return _inflection + (std::log(1.0 / w - 1.0) / -_slope);
+    }
+
     std::string Sigmoid::parameters() const {
         return Op::join(2, " ", _inflection, _slope) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
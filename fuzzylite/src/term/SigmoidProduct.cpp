@@ -45,6 +45,17 @@ namespace fl {
         return _height * a * b;
     }
 
+    void SigmoidProduct::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar rising = -_rising, falling = -_falling, left = _left, right = _right, h = _height;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar a = 1.0 / (1 + std::exp(rising * (xi - left)));
+            scalar b = 1.0 / (1 + std::exp(falling * (xi - right)));
+            scalar mu = h * a * b;
+            y[i] = mu;
+        }
+    }
+
     std::string SigmoidProduct::parameters() const {
         return Op::join(4, " ", _left, _rising, _falling, _right) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
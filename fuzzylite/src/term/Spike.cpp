@@ -43,6 +43,16 @@ namespace fl {
         return _height * std::exp(-std::fabs(10.0 / _width * (x - _center)));
     }
 
+    void Spike::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar center = _center, h = _height;
+        const scalar scale = 10.0 / _width;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu = h * std::exp(-std::fabs(scale * (xi - center)));
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
     std::string Spike::parameters() const {
         return Op::join(2, " ", _center, _width) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
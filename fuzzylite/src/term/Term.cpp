@@ -58,10 +58,58 @@ namespace fl {
         return FllExporter().toString(this);
     }
 
+    scalar Term::membership(scalar x, const Context& context) const {
+        (void) context;
+        return membership(x);
+    }
+
+    void Term::membership(const scalar* x, scalar* y, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = membership(x[i]);
+        }
+    }
+
+    void Term::membership(const scalar* x, scalar* y, std::size_t n, const Context& context) const {
+        (void) context;
+        membership(x, y, n);
+    }
+
+    void Term::support(scalar& minimum, scalar& maximum) const {
+        minimum = -fl::inf;
+        maximum = fl::inf;
+    }
+
+    bool Term::isMonotonic() const {
+        return false;
+    }
+
+    bool Term::isTakagiSugeno() const {
+        return false;
+    }
+
+    bool Term::dependsOnVariables() const {
+        return false;
+    }
+
+    scalar Term::tsukamoto(scalar activationDegree, scalar minimum, scalar maximum) const {
+        if (not isMonotonic()) return membership(activationDegree);
+        //Bisection over the range, in the direction in which the membership increases
+        bool increasing = membership(minimum) <= membership(maximum);
+        scalar a = minimum, b = maximum;
+        scalar z = 0.5 * (a + b);
+        for (int i = 0; i < 100 and z != a and z != b; ++i) {
+            if ((membership(z) < activationDegree) == increasing) a = z;
+            else b = z;
+            z = 0.5 * (a + b);
+        }
+        return z;
+    }
+
     void Term::updateReference(Term* term, const Engine* engine) {
         if (Linear * linear = dynamic_cast<Linear*> (term)) {
             linear->setEngine(engine);
         } else if (Function * function = dynamic_cast<Function*> (term)) {
+            if (function->getEngine() == engine and function->isCompiled()) return;
             function->setEngine(engine);
             try {
                 function->load();
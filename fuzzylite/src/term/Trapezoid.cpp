@@ -63,6 +63,33 @@ namespace fl {
         return _height * 0.0;
     }
 
+    void Trapezoid::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar a = _vertexA, b = _vertexB, c = _vertexC, d = _vertexD, h = _height;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if ((xi < a and not (a - xi < eps)) or (xi > d and not (xi - d < eps))) {
+                mu = h * 0.0;
+            } else if (xi < b and not (b - xi < eps)) {
+                scalar rising = (xi - a) / (b - a);
+                mu = h * (rising < 1.0 ? rising : scalar(1.0));
+            } else if (xi <= c or xi - c < eps) {
+                mu = h * 1.0;
+            } else if (xi < d and not (d - xi < eps)) {
+                mu = h * (d - xi) / (d - c);
+            } else {
+                mu = h * 0.0;
+            }
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void Trapezoid::support(scalar& minimum, scalar& maximum) const {
+        minimum = _vertexA;
+        maximum = _vertexD;
+    }
+
     std::string Trapezoid::parameters() const {
         return Op::join(4, " ", _vertexA, _vertexB, _vertexC, _vertexD)+
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
@@ -57,6 +57,25 @@ namespace fl {
         return _height * (_vertexC - x) / (_vertexC - _vertexB);
     }
 
+    void Triangle::membership(const scalar* x, scalar* y, std::size_t n) const {
+        const scalar eps = fuzzylite::macheps();
+        const scalar a = _vertexA, b = _vertexB, c = _vertexC, h = _height;
+        for (std::size_t i = 0; i < n; ++i) {
+            const scalar xi = x[i];
+            scalar mu;
+            if ((xi < a and not (a - xi < eps)) or (xi > c and not (xi - c < eps))) mu = h * 0.0;
+            else if (xi == b or std::fabs(xi - b) < eps) mu = h * 1.0;
+            else if (xi < b) mu = h * (xi - a) / (b - a);
+            else mu = h * (c - xi) / (c - b);
+            y[i] = (xi == xi) ? mu : fl::nan;
+        }
+    }
+
+    void Triangle::support(scalar& minimum, scalar& maximum) const {
+        minimum = _vertexA;
+        maximum = _vertexC;
+    }
+
     std::string Triangle::parameters() const {
         return Op::join(3, " ", _vertexA, _vertexB, _vertexC) +
                 (not Op::isEq(_height, 1.0) ? " " + Op::str(_height) : "");
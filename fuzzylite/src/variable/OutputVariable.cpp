@@ -24,11 +24,18 @@
 
 #include "fl/variable/OutputVariable.h"
 
+#include "fl/Context.h"
 #include "fl/defuzzifier/Defuzzifier.h"
+#include "fl/defuzzifier/IntegralDefuzzifier.h"
 #include "fl/imex/FllExporter.h"
 #include "fl/norm/SNorm.h"
+#include "fl/norm/TNorm.h"
 #include "fl/term/Accumulated.h"
 #include "fl/term/Activated.h"
+#include "fl/term/Function.h"
+#include "fl/term/Linear.h"
+
+#include <algorithm>
 
 namespace fl {
 
@@ -66,6 +73,8 @@ namespace fl {
         _defaultValue = other._defaultValue;
         _lockOutputValueInRange = other._lockOutputValueInRange;
         _lockPreviousOutputValue = other._lockPreviousOutputValue;
+        _sampledTerms = other._sampledTerms;
+        _sampledSupports = other._sampledSupports;
     }
 
     void OutputVariable::setName(const std::string& name) {
@@ -80,15 +89,18 @@ namespace fl {
     void OutputVariable::setMinimum(scalar minimum) {
         Variable::setMinimum(minimum);
         this->_fuzzyOutput->setMinimum(minimum);
+        clearSampledTerms();
     }
 
     void OutputVariable::setMaximum(scalar maximum) {
         Variable::setMaximum(maximum);
         this->_fuzzyOutput->setMaximum(maximum);
+        clearSampledTerms();
     }
 
     void OutputVariable::setDefuzzifier(Defuzzifier* defuzzifier) {
         this->_defuzzifier.reset(defuzzifier);
+        clearSampledTerms();
     }
 
     Defuzzifier* OutputVariable::getDefuzzifier() const {
@@ -165,6 +177,155 @@ namespace fl {
         this->_outputValue = result;
     }
 
+    void OutputVariable::defuzzify(Context& context, int index) const {
+        scalar previousOutputValue = context.getPreviousOutputValue(index);
+        if (fl::Op::isFinite(context.getOutputValue(index))) {
+            previousOutputValue = context.getOutputValue(index);
+        }
+
+        const Accumulated* fuzzyOutput = context.fuzzyOutput(index);
+        scalar result = fl::nan;
+        bool isValid = this->_enabled and not fuzzyOutput->isEmpty();
+        if (isValid) {
+            if (not _defuzzifier.get()) {
+                throw fl::Exception("[defuzzifier error] "
+                        "defuzzifier needed to defuzzify output variable <" + _name + ">", FL_AT);
+            }
+            const IntegralDefuzzifier* integral = dynamic_cast<const IntegralDefuzzifier*> (_defuzzifier.get());
+            if (integral and not integral->isAnalytical() and not (integral->getTolerance() > 0.0)
+                    and accumulate(fuzzyOutput, context.samples(index))) {
+                result = static_cast<const IntegralDefuzzifier*> (_defuzzifier.get())
+                        ->defuzzifySamples(context.samples(index), _minimum, _maximum, context);
+            } else {
+                result = this->_defuzzifier->defuzzify(fuzzyOutput, _minimum, _maximum);
+            }
+        } else {
+            if (_lockPreviousOutputValue and not Op::isNaN(previousOutputValue)) {
+                result = previousOutputValue;
+            } else {
+                result = _defaultValue;
+            }
+        }
+
+        if (_lockOutputValueInRange) {
+            result = fl::Op::bound(result, _minimum, _maximum);
+        }
+
+        context.setPreviousOutputValue(index, previousOutputValue);
+        context.setOutputValue(index, result);
+    }
+
+    void OutputVariable::sampleTerms() {
+        clearSampledTerms();
+        const IntegralDefuzzifier* integral = dynamic_cast<const IntegralDefuzzifier*> (_defuzzifier.get());
+        if (not (integral and integral->getResolution() > 0 and fl::Op::isFinite(_minimum + _maximum)))
+            return;
+        for (std::size_t t = 0; t < _terms.size(); ++t) {
+            //the membership of these terms depends on the input values
+            if (dynamic_cast<const Linear*> (_terms.at(t)) or dynamic_cast<const Function*> (_terms.at(t)))
+                return;
+        }
+
+        int resolution = integral->getResolution();
+        scalar dx = (_maximum - _minimum) / resolution;
+        _sampledTerms.resize(_terms.size());
+        _sampledSupports.resize(_terms.size());
+        std::vector<scalar> x(resolution);
+        for (int i = 0; i < resolution; ++i) {
+            x.at(i) = _minimum + (i + 0.5) * dx;
+        }
+        for (std::size_t t = 0; t < _terms.size(); ++t) {
+            std::vector<scalar>& samples = _sampledTerms.at(t);
+            samples.resize(resolution);
+            _terms.at(t)->membership(&x.at(0), &samples.at(0), resolution);
+            int first = resolution, last = -1;
+            for (int i = 0; i < resolution; ++i) {
+                if (samples.at(i) != 0.0) {
+                    first = std::min(first, i);
+                    last = i;
+                }
+            }
+            _sampledSupports.at(t) = std::make_pair(first, last);
+        }
+    }
+
+    void OutputVariable::clearSampledTerms() {
+        _sampledTerms.clear();
+        _sampledSupports.clear();
+    }
+
+    bool OutputVariable::hasSampledTerms() const {
+        return not _sampledTerms.empty();
+    }
+
+    bool OutputVariable::accumulate(const Accumulated* fuzzyOutput, std::vector<scalar>& samples) const {
+        if (_sampledTerms.size() != _terms.size() or _sampledTerms.empty()) return false;
+        const IntegralDefuzzifier* integral = dynamic_cast<const IntegralDefuzzifier*> (_defuzzifier.get());
+        const SNorm* accumulation = fuzzyOutput->getAccumulation();
+        std::size_t resolution = _sampledTerms.front().size();
+        if (not (integral and accumulation and resolution > 0
+                and integral->getResolution() == int(resolution))) {
+            return false;
+        }
+
+        samples.assign(resolution, 0.0);
+        scalar* y = &samples.at(0);
+        const bool maximum = accumulation->kernel() == Norm::MaximumKernel;
+        const std::size_t blockSize = 128;
+        scalar degrees[blockSize], activations[blockSize];
+        for (int a = 0; a < fuzzyOutput->numberOfTerms(); ++a) {
+            const Activated* activated = fuzzyOutput->getTerm(a);
+            const TNorm* activation = activated->getActivation();
+            //the index resolved by the consequent, unless unresolved or stale
+            std::size_t t = std::size_t(activated->getTermIndex());
+            if (not (t < _terms.size() and _terms[t] == activated->getTerm())) {
+                t = std::find(_terms.begin(), _terms.end(), activated->getTerm()) - _terms.begin();
+            }
+            if (not activation or t == _terms.size() or fl::Op::isNaN(activated->getDegree()))
+                return false;
+
+            const scalar* mu = &_sampledTerms.at(t).at(0);
+            const scalar degree = activated->getDegree();
+            //outside of the support of the term, S(y, T(0, degree)) = y
+            const int first = _sampledSupports.at(t).first, last = _sampledSupports.at(t).second;
+            if (maximum and activation->kernel() == Norm::MinimumKernel) {
+                for (int i = first; i <= last; ++i) {
+                    scalar clipped = mu[i] < degree ? mu[i] : degree;
+                    y[i] = y[i] < clipped ? clipped : y[i];
+                }
+            } else if (maximum and activation->kernel() == Norm::AlgebraicProductKernel) {
+                for (int i = first; i <= last; ++i) {
+                    scalar scaled = mu[i] * degree;
+                    y[i] = y[i] < scaled ? scaled : y[i];
+                }
+            } else {
+                std::fill(degrees, degrees + blockSize, degree);
+                for (int i = first; i <= last; i += blockSize) {
+                    const std::size_t size = std::min(std::size_t(last - i + 1), blockSize);
+                    activation->compute(mu + i, degrees, activations, size);
+                    accumulation->compute(y + i, activations, y + i, size);
+                }
+            }
+        }
+        return true;
+    }
+
+    IntegralDefuzzifier::Sweep OutputVariable::sweep(Context& context, int index) const {
+        const Accumulated* fuzzyOutput = context.fuzzyOutput(index);
+        std::vector<scalar>& samples = context.samples(index);
+        if (not (fl::Op::isFinite(_minimum + _maximum) and _enabled and not fuzzyOutput->isEmpty()))
+            return IntegralDefuzzifier::Sweep();
+
+        if (not accumulate(fuzzyOutput, samples)) {
+            const IntegralDefuzzifier* integral = dynamic_cast<const IntegralDefuzzifier*> (_defuzzifier.get());
+            int resolution = integral ? integral->getResolution() : IntegralDefuzzifier::defaultResolution();
+            const std::vector<scalar>& grid = context.grid(_minimum, _maximum, resolution);
+            samples.resize(grid.size());
+            if (not grid.empty()) fuzzyOutput->membership(&grid[0], &samples[0], grid.size(), context.buffer());
+        }
+        return IntegralDefuzzifier::sweep(samples, _minimum, _maximum);
+    }
+
     std::string OutputVariable::fuzzyOutputValue() const {
         std::ostringstream ss;
         for (std::size_t i = 0; i < _terms.size(); ++i) {
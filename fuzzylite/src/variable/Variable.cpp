@@ -24,6 +24,7 @@
 
 #include "fl/variable/Variable.h"
 
+#include "fl/Engine.h"
 #include "fl/defuzzifier/Centroid.h"
 #include "fl/imex/FllExporter.h"
 #include "fl/norm/Norm.h"
@@ -38,7 +39,8 @@
 namespace fl {
 
     Variable::Variable(const std::string& name, scalar minimum, scalar maximum)
-    : _name(name), _minimum(minimum), _maximum(maximum), _enabled(true) {
+    : _name(name), _minimum(minimum), _maximum(maximum), _enabled(true),
+    _revision(Engine::nextRevision()) {
     }
 
     Variable::Variable(const Variable& other) {
@@ -61,6 +63,7 @@ namespace fl {
         _enabled = other._enabled;
         _minimum = other._minimum;
         _maximum = other._maximum;
+        _revision = Engine::nextRevision();
         for (std::size_t i = 0; i < other._terms.size(); ++i) {
             _terms.push_back(other._terms.at(i)->clone());
         }
@@ -172,6 +175,10 @@ namespace fl {
         }
     };
 
+    unsigned long Variable::revision() const {
+        return this->_revision;
+    }
+
     void Variable::sort() {
         Centroid defuzzifier;
         std::map<const Term*, scalar> centroids;
@@ -190,14 +197,17 @@ namespace fl {
         SortByCoG criterion;
         criterion.centroids = centroids;
         std::sort(_terms.begin(), _terms.end(), criterion);
+        this->_revision = Engine::nextRevision();
     }
 
     void Variable::addTerm(Term* term) {
         this->_terms.push_back(term);
+        this->_revision = Engine::nextRevision();
     }
 
     void Variable::insertTerm(Term* term, int index) {
         this->_terms.insert(this->_terms.begin() + index, term);
+        this->_revision = Engine::nextRevision();
     }
 
     Term* Variable::getTerm(int index) const {
@@ -221,6 +231,7 @@ namespace fl {
     Term* Variable::removeTerm(int index) {
         Term* result = this->_terms.at(index);
         this->_terms.erase(this->_terms.begin() + index);
+        this->_revision = Engine::nextRevision();
         return result;
     }
 
@@ -234,6 +245,7 @@ namespace fl {
 
     void Variable::setTerms(const std::vector<Term*>& terms) {
         this->_terms = terms;
+        this->_revision = Engine::nextRevision();
     }
 
     std::vector<Term*>& Variable::terms() {
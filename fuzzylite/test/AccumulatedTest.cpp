@@ -0,0 +1,72 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+using namespace fl;
+
+//Activates the term twice, with the degrees 0.25 and 0.75
+static void activate(Accumulated& accumulated, const Term* term, const TNorm* activation,
+        bool groupByTerm) {
+    accumulated.setGroupByTerm(groupByTerm);
+    accumulated.addTerm(term, 0.25, activation);
+    accumulated.addTerm(term, 0.75, activation);
+}
+
+static void testGroupByTerm() {
+    Triangle triangle("A", 0.0, 0.5, 1.0);
+    AlgebraicProduct activation;
+    const scalar x[] = {0.1, 0.25, 0.5, 0.75, 0.9};
+
+    //Maximum groups the activations of the same term into one
+    Accumulated maximum("maximum", 0.0, 1.0, new Maximum);
+    activate(maximum, &triangle, &activation, true);
+    FL_CHECK(maximum.numberOfTerms() == 1);
+    Accumulated expected("expected", 0.0, 1.0, new Maximum);
+    activate(expected, &triangle, &activation, false);
+    FL_CHECK(expected.numberOfTerms() == 2);
+    for (std::size_t i = 0; i < sizeof (x) / sizeof (x[0]); ++i) {
+        FL_CHECK(maximum.membership(x[i]) == expected.membership(x[i]));
+    }
+
+    //other accumulations keep the activations apart, which preserves the membership
+    Accumulated sum("sum", 0.0, 1.0, new AlgebraicSum);
+    activate(sum, &triangle, &activation, true);
+    FL_CHECK(sum.numberOfTerms() == 2);
+    for (std::size_t i = 0; i < sizeof (x) / sizeof (x[0]); ++i) {
+        const scalar a = 0.25 * triangle.membership(x[i]);
+        const scalar b = 0.75 * triangle.membership(x[i]);
+        FL_CHECK(test::isClose(sum.membership(x[i]), a + b - a * b, 1e-15));
+    }
+}
+
+int main() {
+    try {
+        testGroupByTerm();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
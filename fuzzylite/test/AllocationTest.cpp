@@ -0,0 +1,98 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <new>
+#include <vector>
+
+static unsigned long allocations = 0;
+
+#ifdef FL_CPP11
+void* operator new(std::size_t size) {
+#else
+void* operator new(std::size_t size) throw (std::bad_alloc) {
+#endif
+    ++allocations;
+    void* result = std::malloc(size ? size : 1);
+    if (not result) throw std::bad_alloc();
+    return result;
+}
+
+void operator delete(void* pointer) FL_INOEXCEPT {
+    std::free(pointer);
+}
+
+using namespace fl;
+
+//Evaluates the rows on the context, and returns the heap allocations made
+static unsigned long evaluate(const Engine* engine, Context& context,
+        const std::vector<scalar>& inputValues, std::size_t rows) {
+    const unsigned long start = allocations;
+    const std::size_t inputs = engine->numberOfInputVariables();
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t i = 0; i < inputs; ++i) {
+            context.setInputValue(i, inputValues.at(i * rows + row));
+        }
+        engine->process(context);
+    }
+    return allocations - start;
+}
+
+static void testNoAllocationsWhenProcessing(const std::string& path) {
+    const char* examples[] = {"/mamdani/AllTerms", "/mamdani/SimpleDimmer",
+        "/mamdani/matlab/mam21", "/mamdani/matlab/mam22", "/mamdani/matlab/shower",
+        "/mamdani/matlab/tank", "/mamdani/matlab/tank2", "/mamdani/matlab/tipper",
+        "/mamdani/matlab/tipper1", "/mamdani/octave/investment_portfolio",
+        "/mamdani/octave/mamdani_tip_calculator", "/takagi-sugeno/approximation",
+        "/takagi-sugeno/SimpleDimmer", "/takagi-sugeno/matlab/fpeaks",
+        "/takagi-sugeno/matlab/invkine1", "/takagi-sugeno/matlab/juggler",
+        "/takagi-sugeno/matlab/membrn1", "/takagi-sugeno/matlab/slbb",
+        "/takagi-sugeno/octave/cubic_approximator", "/takagi-sugeno/octave/sugeno_tip_calculator",
+        "/tsukamoto/tsukamoto"};
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        engine->restart();
+        DataReader data(engine.get(), 256);
+        std::vector<scalar> inputValues;
+        std::size_t rows = data.read(inputValues, 256);
+        Context context(engine.get());
+        //the first pass sizes the buffers, after which the activated terms are reused
+        evaluate(engine.get(), context, inputValues, rows);
+        unsigned long count = evaluate(engine.get(), context, inputValues, rows);
+        if (not FL_CHECK(count == 0)) {
+            std::cerr << examples[e] << ": " << count << " allocations in " << rows << " rows" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        testNoAllocationsWhenProcessing(test::examples(argc, argv));
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
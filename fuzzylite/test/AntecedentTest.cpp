@@ -0,0 +1,147 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <vector>
+
+using namespace fl;
+
+//Rules with hedges, parentheses, and propositions on output variables
+static const char* hedges =
+        "Engine: hedges\n"
+        "InputVariable: A\n"
+        "  range: 0.000 1.000\n"
+        "  term: low Ramp 1.000 0.000\n"
+        "  term: high Ramp 0.000 1.000\n"
+        "InputVariable: B\n"
+        "  range: 0.000 1.000\n"
+        "  term: low Triangle 0.000 0.000 0.750\n"
+        "  term: high Triangle 0.250 1.000 1.000\n"
+        "OutputVariable: Y\n"
+        "  range: 0.000 1.000\n"
+        "  accumulation: Maximum\n"
+        "  defuzzifier: Centroid 100\n"
+        "  term: low Triangle 0.000 0.250 0.500\n"
+        "  term: high Triangle 0.500 0.750 1.000\n"
+        "OutputVariable: Z\n"
+        "  range: 0.000 1.000\n"
+        "  accumulation: Maximum\n"
+        "  defuzzifier: Centroid 100\n"
+        "  term: low Triangle 0.000 0.250 0.500\n"
+        "  term: high Triangle 0.500 0.750 1.000\n"
+        "RuleBlock: first\n"
+        "  conjunction: AlgebraicProduct\n"
+        "  disjunction: AlgebraicSum\n"
+        "  activation: Minimum\n"
+        "  rule: if A is low and (B is high or A is not high) then Y is low\n"
+        "  rule: if (A is very high or B is low) and B is somewhat high then Y is high\n"
+        "  rule: if A is any and B is seldom low then Y is low\n"
+        "RuleBlock: second\n"
+        "  conjunction: Minimum\n"
+        "  disjunction: Maximum\n"
+        "  activation: Minimum\n"
+        "  rule: if Y is high and A is extremely low then Z is high\n"
+        "  rule: if Y is low or B is high then Z is low\n";
+
+/**
+ * Evaluates the rows on a context sharing the fuzzy outputs of the engine,
+ * and returns the number of rules whose compiled program disagrees with the
+ * evaluation of their expression on the variables of the engine
+ */
+static int mismatches(Engine* engine, const std::vector<scalar>& inputValues, std::size_t rows) {
+    Context context;
+    context.load(engine, true);
+    int result = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+            context.setInputValue(i, inputValues.at(i * rows + row));
+            engine->getInputVariable(i)->setInputValue(inputValues.at(i * rows + row));
+        }
+        engine->process(context);
+        for (int b = 0; b < engine->numberOfRuleBlocks(); ++b) {
+            const RuleBlock* ruleBlock = engine->getRuleBlock(b);
+            for (int r = 0; r < ruleBlock->numberOfRules(); ++r) {
+                const Antecedent* antecedent = ruleBlock->getRule(r)->getAntecedent();
+                scalar compiled = antecedent->activationDegree(ruleBlock->getConjunction(),
+                        ruleBlock->getDisjunction(), context);
+                scalar expected = antecedent->activationDegree(ruleBlock->getConjunction(),
+                        ruleBlock->getDisjunction());
+                if (not (compiled == expected or (Op::isNaN(compiled) and Op::isNaN(expected)))) {
+                    ++result;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+static void testCompiledAntecedents(const std::string& path) {
+    const char* examples[] = {"/mamdani/AllTerms", "/mamdani/Laundry",
+        "/mamdani/matlab/mam21", "/mamdani/matlab/tipper", "/mamdani/octave/investment_portfolio",
+        "/takagi-sugeno/approximation", "/takagi-sugeno/matlab/fpeaks",
+        "/takagi-sugeno/octave/sugeno_tip_calculator", "/tsukamoto/tsukamoto"};
+    std::vector<Engine*> engines;
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        engines.push_back(test::importEngine(path + examples[e] + ".fll"));
+    }
+    engines.push_back(FllImporter().fromString(hedges));
+    for (std::size_t e = 0; e < engines.size(); ++e) {
+        FL_unique_ptr<Engine> engine(engines.at(e));
+        engine->restart();
+        DataReader data(engine.get(), 256);
+        std::vector<scalar> inputValues;
+        const std::size_t rows = data.read(inputValues, 256);
+        if (not FL_CHECK(mismatches(engine.get(), inputValues, rows) == 0)) {
+            std::cerr << engine->getName() << std::endl;
+        }
+    }
+}
+
+static void testStructuralChange() {
+    FL_unique_ptr<Engine> engine(FllImporter().fromString(hedges));
+    engine->restart();
+    const Antecedent* antecedent = engine->getRuleBlock(0)->getRule(0)->getAntecedent();
+    FL_CHECK(not antecedent->instructions().empty());
+
+    //the slots of the terms after the new one no longer match until compiled again
+    engine->getInputVariable(0)->insertTerm(new Triangle("middle", 0.25, 0.5, 0.75), 0);
+    DataReader data(engine.get(), 64);
+    std::vector<scalar> inputValues;
+    const std::size_t rows = data.read(inputValues, 64);
+    FL_CHECK(mismatches(engine.get(), inputValues, rows) == 0);
+    engine->restart();
+    FL_CHECK(mismatches(engine.get(), inputValues, rows) == 0);
+}
+
+int main(int argc, char** argv) {
+    try {
+        testCompiledAntecedents(test::examples(argc, argv));
+        testStructuralChange();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
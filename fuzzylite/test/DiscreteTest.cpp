@@ -0,0 +1,121 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <vector>
+
+using namespace fl;
+
+//Values of x around and between the pairs, and beyond them
+static std::vector<scalar> values(const Discrete& discrete) {
+    std::vector<scalar> result;
+    const std::vector<Discrete::Pair>& xy = discrete.xy();
+    for (std::size_t i = 0; i < xy.size(); ++i) {
+        const scalar x = xy.at(i).first;
+        result.push_back(x);
+        result.push_back(x - 1e-12);
+        result.push_back(x + 1e-12);
+        result.push_back(x - 0.1);
+        result.push_back(x + 0.37);
+    }
+    for (int i = 0; i <= 1000; ++i) {
+        result.push_back(-1.0 + 0.013 * i);
+    }
+    result.push_back(fl::nan);
+    result.push_back(-fl::inf);
+    result.push_back(fl::inf);
+    return result;
+}
+
+/**
+ * Compares the membership of the term, searched as indexed, with that of a
+ * copy whose index is disabled, which scans the pairs
+ */
+static int mismatches(const Discrete& indexed) {
+    Discrete scanned(indexed);
+    scanned.xy();
+    FL_CHECK(not scanned.isSorted());
+    std::vector<scalar> x = values(indexed);
+    std::vector<scalar> y(x.size());
+    indexed.membership(&x.front(), &y.front(), x.size());
+    int result = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        const scalar expected = scanned.membership(x.at(i));
+        if (not test::isClose(indexed.membership(x.at(i)), expected, 0.0)) ++result;
+        if (not test::isClose(y.at(i), expected, 0.0)) ++result;
+    }
+    return result;
+}
+
+static void testSearches() {
+    std::vector<Discrete::Pair> uniform;
+    for (int i = 0; i <= 50; ++i) {
+        uniform.push_back(Discrete::Pair(-0.5 + 0.02 * i, std::sin(0.3 * i) * std::sin(0.3 * i)));
+    }
+    Discrete equallySpaced("uniform", uniform);
+    FL_CHECK(equallySpaced.isSorted());
+    FL_CHECK(equallySpaced.isUniform());
+    FL_CHECK(mismatches(equallySpaced) == 0);
+
+    std::vector<Discrete::Pair> sorted;
+    for (int i = 0; i <= 50; ++i) {
+        sorted.push_back(Discrete::Pair(0.001 * i * i - 0.7, 0.5 + 0.5 * std::cos(0.2 * i)));
+    }
+    Discrete increasing("sorted", sorted);
+    FL_CHECK(increasing.isSorted());
+    FL_CHECK(not increasing.isUniform());
+    FL_CHECK(mismatches(increasing) == 0);
+
+    //repeated values of x make steps
+    sorted.insert(sorted.begin() + 10, sorted.at(10));
+    sorted.at(10).second = 1.0 - sorted.at(10).second;
+    sorted.insert(sorted.begin() + 31, Discrete::Pair(sorted.at(30).first + 1e-12, 0.25));
+    Discrete steps("steps", sorted);
+    FL_CHECK(steps.isSorted());
+    FL_CHECK(mismatches(steps) == 0);
+
+    std::swap(sorted.at(5), sorted.at(20));
+    Discrete unsorted("unsorted", sorted);
+    FL_CHECK(not unsorted.isSorted());
+    FL_CHECK(mismatches(unsorted) == 0);
+
+    //editing the pairs disables the index until updated
+    equallySpaced.xy().at(25).first += 0.015;
+    FL_CHECK(not equallySpaced.isSorted());
+    equallySpaced.updateIndex();
+    FL_CHECK(equallySpaced.isSorted());
+    FL_CHECK(not equallySpaced.isUniform());
+    FL_CHECK(mismatches(equallySpaced) == 0);
+}
+
+int main() {
+    try {
+        testSearches();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
@@ -0,0 +1,121 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+using namespace fl;
+
+static void testRevision(const std::string& path) {
+    FL_unique_ptr<Engine> engine(test::importEngine(path + "/takagi-sugeno/matlab/fpeaks.fll"));
+    engine->restart();
+    const unsigned long revision = engine->revision();
+    //reading through the mutable references leaves the engine unchanged
+    engine->inputVariables().at(0)->setInputValue(0.5);
+    engine->outputVariables().at(0)->terms().size();
+    FL_CHECK(engine->revision() == revision);
+
+    engine->getOutputVariable(0)->addTerm(new Constant("extra", 1.0));
+    FL_CHECK(engine->revision() > revision);
+
+    //edits through the mutable references are tracked once the engine is restarted
+    const unsigned long added = engine->revision();
+    delete engine->getOutputVariable(0)->terms().back();
+    engine->getOutputVariable(0)->terms().pop_back();
+    FL_CHECK(engine->revision() == added);
+    engine->restart();
+    FL_CHECK(engine->revision() > added);
+}
+
+static void testContextAfterRestart(const std::string& path) {
+    FL_unique_ptr<Engine> engine(test::importEngine(path + "/mamdani/SimpleDimmer.fll"));
+    engine->restart();
+    Context context(engine.get());
+    FL_CHECK(context.isLoaded(engine.get()));
+    engine->getInputVariable(0)->setInputValue(0.25);
+    engine->process();
+    FL_CHECK(context.isLoaded(engine.get()));
+    engine->restart();
+    FL_CHECK(not context.isLoaded(engine.get()));
+}
+
+//Whether the values are identical, or both nan
+static bool isSame(scalar a, scalar b) {
+    return a == b or (Op::isNaN(a) and Op::isNaN(b));
+}
+
+static void testBatchProcess(const std::string& path) {
+    const char* examples[] = {"/mamdani/AllTerms", "/mamdani/SimpleDimmer",
+        "/mamdani/matlab/mam21", "/mamdani/matlab/tank2", "/mamdani/octave/investment_portfolio",
+        "/takagi-sugeno/approximation", "/takagi-sugeno/SimpleDimmer",
+        "/takagi-sugeno/matlab/fpeaks", "/takagi-sugeno/matlab/invkine1",
+        "/takagi-sugeno/matlab/slbb", "/takagi-sugeno/octave/cubic_approximator",
+        "/tsukamoto/tsukamoto"};
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        engine->restart();
+        //rows that do not fill the last block
+        DataReader data(engine.get(), 300);
+        std::vector<scalar> inputValues;
+        const std::size_t rows = data.read(inputValues, 1000);
+        const std::size_t inputs = engine->numberOfInputVariables();
+        const std::size_t outputs = engine->numberOfOutputVariables();
+        std::vector<scalar> outputValues(outputs * rows);
+        engine->process(&inputValues.front(), rows, &outputValues.front());
+
+        Context context(engine.get());
+        int mismatches = 0;
+        for (std::size_t row = 0; row < rows; ++row) {
+            for (std::size_t i = 0; i < inputs; ++i) {
+                context.setInputValue(i, inputValues.at(i * rows + row));
+            }
+            engine->process(context);
+            for (std::size_t i = 0; i < outputs; ++i) {
+                if (not isSame(context.getOutputValue(i), outputValues.at(i * rows + row))) ++mismatches;
+            }
+        }
+        if (not FL_CHECK(mismatches == 0)) std::cerr << examples[e] << std::endl;
+
+        //the values evaluated for the batch do not remain for the next evaluation
+        engine->getInputVariable(0)->setInputValue(inputValues.at(0));
+        engine->process();
+        context.setInputValue(0, inputValues.at(0));
+        for (std::size_t i = 1; i < inputs; ++i) {
+            context.setInputValue(i, engine->getInputVariable(i)->getInputValue());
+        }
+        engine->process(context);
+        FL_CHECK(isSame(engine->getOutputVariable(0)->getOutputValue(), context.getOutputValue(0)));
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        testRevision(test::examples(argc, argv));
+        testContextAfterRestart(test::examples(argc, argv));
+        testBatchProcess(test::examples(argc, argv));
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
@@ -0,0 +1,176 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <vector>
+
+using namespace fl;
+
+//Checks the outputs of each row of the flb data are those of evaluating the engine on its inputs
+static std::size_t checkResults(Engine* engine, const std::string& flb) {
+    FlbExporter exporter;
+    std::istringstream reader(flb);
+    std::string name;
+    std::vector<std::string> inputNames, outputNames;
+    bool single;
+    exporter.readHeader(reader, name, inputNames, outputNames, single);
+    FL_CHECK(name == engine->getName());
+    FL_CHECK(not single);
+    FL_CHECK(inputNames.size() == std::size_t(engine->numberOfInputVariables()));
+    FL_CHECK(outputNames.size() == std::size_t(engine->numberOfOutputVariables()));
+    for (std::size_t i = 0; i < inputNames.size() and i < outputNames.size(); ++i) {
+        FL_CHECK(inputNames.at(i) == engine->getInputVariable(i)->getName());
+    }
+
+    Context context(engine);
+    const std::size_t inputs = inputNames.size(), outputs = outputNames.size();
+    std::vector<scalar> values;
+    std::size_t result = 0;
+    int mismatches = 0;
+    while (std::size_t rows = exporter.readBlock(reader, inputs + outputs, single, values)) {
+        for (std::size_t row = 0; row < rows; ++row) {
+            for (std::size_t i = 0; i < inputs; ++i) {
+                context.setInputValue(i, values.at(i * rows + row));
+            }
+            engine->process(context);
+            for (std::size_t i = 0; i < outputs; ++i) {
+                scalar expected = context.getOutputValue(i);
+                scalar obtained = values.at((inputs + i) * rows + row);
+                if (not (expected == obtained or (Op::isNaN(expected) and Op::isNaN(obtained)))) {
+                    ++mismatches;
+                }
+            }
+        }
+        result += rows;
+    }
+    FL_CHECK(mismatches == 0);
+    return result;
+}
+
+//Values of all the blocks of the flb data, one after the other
+static std::vector<scalar> readValues(const std::string& flb) {
+    FlbExporter exporter;
+    std::istringstream reader(flb);
+    std::string name;
+    std::vector<std::string> inputNames, outputNames;
+    bool single;
+    exporter.readHeader(reader, name, inputNames, outputNames, single);
+    std::vector<scalar> result, values;
+    while (exporter.readBlock(reader, inputNames.size() + outputNames.size(), single, values)) {
+        result.insert(result.end(), values.begin(), values.end());
+    }
+    return result;
+}
+
+static void testRoundTrip(const std::string& path) {
+    const char* examples[] = {"/mamdani/SimpleDimmer", "/mamdani/octave/investment_portfolio",
+        "/takagi-sugeno/matlab/fpeaks", "/tsukamoto/tsukamoto"};
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        engine->restart();
+        FlbExporter exporter;
+        exporter.setSinglePrecision(false);
+        //several blocks, the last of which is partial
+        exporter.setRowsPerBlock(300);
+        const std::string flb = exporter.toString(engine.get(), 1024);
+        FL_CHECK(flb.size() % 8 == 0);
+        FL_CHECK(checkResults(engine.get(), flb) > 300);
+
+        //the inputs read from flb give the same flb
+        FL_CHECK(exporter.toString(engine.get(), flb) == flb);
+
+        //the inputs read from flb give the same fld as those of the grid
+        FldExporter fldExporter;
+        std::istringstream reader(flb);
+        std::ostringstream fromFlb, fromGrid;
+        fldExporter.write(engine.get(), fromFlb, reader);
+        fldExporter.write(engine.get(), fromGrid, 1024);
+        FL_CHECK(fromFlb.str() == fromGrid.str());
+
+        //single precision rounds the same values
+        exporter.setSinglePrecision(true);
+        std::vector<scalar> values = readValues(flb);
+        std::vector<scalar> singleValues = readValues(exporter.toString(engine.get(), 1024));
+        int mismatches = 0;
+        for (std::size_t i = 0; i < values.size() and i < singleValues.size(); ++i) {
+            if (not test::isClose(scalar(float(values.at(i))), singleValues.at(i), 0.0)) ++mismatches;
+        }
+        FL_CHECK(values.size() == singleValues.size());
+        FL_CHECK(mismatches == 0);
+    }
+}
+
+static std::string unsignedBytes(unsigned long x) {
+    std::string result(4, '\0');
+    for (int i = 0; i < 4; ++i) result[i] = char((x >> (8 * i)) & 0xff);
+    return result;
+}
+
+//Whether reading the header fails with an fl::Exception
+static bool failsHeader(const std::string& data) {
+    std::istringstream reader(data);
+    std::string name;
+    std::vector<std::string> inputNames, outputNames;
+    bool single;
+    try {
+        FlbExporter().readHeader(reader, name, inputNames, outputNames, single);
+    } catch (fl::Exception&) {
+        return true;
+    }
+    return false;
+}
+
+static void testCorruptData() {
+    const std::string start = "FLB1" + unsignedBytes(8);
+    FL_CHECK(not failsHeader(start + unsignedBytes(1) + "e" + unsignedBytes(0) + unsignedBytes(0)
+            + std::string(3, '\0')));
+    //sizes beyond the data are rejected before allocating for them
+    FL_CHECK(failsHeader(start + unsignedBytes(0xffffffffUL)));
+    FL_CHECK(failsHeader(start + unsignedBytes(0) + unsignedBytes(0xffffffffUL)));
+    FL_CHECK(failsHeader(start + unsignedBytes(0) + unsignedBytes(2) + unsignedBytes(0xfffffff0UL)));
+    FL_CHECK(failsHeader(start + unsignedBytes(5) + "e"));
+    FL_CHECK(failsHeader("FLB1" + unsignedBytes(2)));
+
+    std::istringstream block(unsignedBytes(0xffffffffUL) + unsignedBytes(0) + std::string(16, '\0'));
+    std::vector<scalar> values;
+    bool fails = false;
+    try {
+        FlbExporter().readBlock(block, 2, false, values);
+    } catch (fl::Exception&) {
+        fails = true;
+    }
+    FL_CHECK(fails);
+}
+
+int main(int argc, char** argv) {
+    try {
+        testRoundTrip(test::examples(argc, argv));
+        testCorruptData();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
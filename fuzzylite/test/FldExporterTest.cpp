@@ -0,0 +1,137 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <vector>
+
+using namespace fl;
+
+//The examples whose results are those in their fld files, which for the other
+//matlab examples are results of earlier versions
+static const char* examples[] = {
+    "/mamdani/AllTerms", "/mamdani/Laundry", "/mamdani/SimpleDimmer",
+    "/mamdani/SimpleDimmerInverse", "/mamdani/matlab/mam21", "/mamdani/matlab/mam22",
+    "/mamdani/matlab/shower", "/mamdani/matlab/tank", "/mamdani/matlab/tank2",
+    "/mamdani/matlab/tipper", "/mamdani/matlab/tipper1",
+    "/mamdani/octave/investment_portfolio", "/mamdani/octave/mamdani_tip_calculator",
+    "/takagi-sugeno/SimpleDimmer", "/takagi-sugeno/approximation",
+    "/takagi-sugeno/matlab/slcpp1", "/takagi-sugeno/matlab/sltbu_fl",
+    "/takagi-sugeno/matlab/sugeno1", "/takagi-sugeno/matlab/tippersg",
+    "/takagi-sugeno/octave/cubic_approximator", "/takagi-sugeno/octave/heart_disease_risk",
+    "/takagi-sugeno/octave/linear_tip_calculator", "/takagi-sugeno/octave/sugeno_tip_calculator",
+    "/tsukamoto/tsukamoto"
+};
+
+static std::string exportGrid(Engine* engine, int threads) {
+    FldExporter exporter;
+    exporter.setThreads(threads);
+    std::ostringstream writer;
+    exporter.write(engine, writer, 1024);
+    return writer.str();
+}
+
+static std::string exportData(Engine* engine, const std::string& data, int threads) {
+    FldExporter exporter;
+    exporter.setThreads(threads);
+    std::istringstream reader(data);
+    std::ostringstream writer;
+    exporter.write(engine, writer, reader);
+    return writer.str();
+}
+
+//The output on any number of threads is that of evaluating serially
+static void testThreads(const std::string& path) {
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        //locking the previous output values would evaluate serially
+        for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+            engine->getOutputVariable(i)->setLockPreviousOutputValue(false);
+        }
+        const std::string data = test::read(path + examples[e] + ".fld");
+        engine->restart();
+        const std::string grid = exportGrid(engine.get(), 1);
+        engine->restart();
+        const std::string serial = exportData(engine.get(), data, 1);
+        const int threads[] = {2, 3, 8};
+        for (std::size_t t = 0; t < sizeof (threads) / sizeof (threads[0]); ++t) {
+            engine->restart();
+            if (not FL_CHECK(exportGrid(engine.get(), threads[t]) == grid)
+                    or not FL_CHECK(exportData(engine.get(), data, threads[t]) == serial)) {
+                std::cerr << examples[e] << " on " << threads[t] << " threads" << std::endl;
+            }
+        }
+    }
+}
+
+//Number of values in the lines of the obtained data that differ from the expected
+static int mismatches(const std::string& expected, const std::string& obtained,
+        scalar tolerance) {
+    FldExporter exporter;
+    std::istringstream expectedReader(expected), obtainedReader(obtained);
+    std::string expectedLine, obtainedLine;
+    std::vector<scalar> expectedValues, obtainedValues;
+    int result = 0;
+    while (std::getline(expectedReader, expectedLine)) {
+        expectedValues.clear();
+        exporter.parse(expectedLine.data(), expectedLine.data() + expectedLine.size(), expectedValues);
+        if (expectedValues.empty()) continue;
+        do {
+            if (not std::getline(obtainedReader, obtainedLine)) return result + 1;
+            obtainedValues.clear();
+            exporter.parse(obtainedLine.data(), obtainedLine.data() + obtainedLine.size(), obtainedValues);
+        } while (obtainedValues.empty());
+        if (expectedValues.size() != obtainedValues.size()) return result + 1;
+        for (std::size_t i = 0; i < expectedValues.size(); ++i) {
+            if (not test::isClose(expectedValues.at(i), obtainedValues.at(i), tolerance)) ++result;
+        }
+    }
+    return result;
+}
+
+//The threads give the results of the examples
+static void testExamples(const std::string& path) {
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        const std::string data = test::read(path + examples[e] + ".fld");
+        engine->restart();
+        int result = mismatches(data, exportData(engine.get(), data, 4), 1e-6);
+        if (not FL_CHECK(result == 0)) {
+            std::cerr << examples[e] << " has " << result << " mismatches" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        //the decimals of the examples
+        fuzzylite::setDecimals(8);
+        testThreads(test::examples(argc, argv));
+        testExamples(test::examples(argc, argv));
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
@@ -0,0 +1,156 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <map>
+#include <vector>
+
+using namespace fl;
+
+//Engine with the input variables a and b, and the output variable y
+static Engine* createEngine() {
+    Engine* engine = new Engine;
+    engine->addInputVariable(new InputVariable("a", -1.0, 1.0));
+    engine->addInputVariable(new InputVariable("b", -1.0, 1.0));
+    engine->addOutputVariable(new OutputVariable("y", -1.0, 1.0));
+    return engine;
+}
+
+static void testBatchEvaluate() {
+    FL_unique_ptr<Engine> engine(createEngine());
+    FL_unique_ptr<Function> function(Function::create("f",
+            "sin(x) * a + b * b - x / (1 + y * y)", engine.get()));
+    FL_CHECK(function->isCompiled());
+
+    //more rows than a block of the program
+    const std::size_t rows = 300;
+    std::vector<scalar> x(rows), a(rows), b(rows), y(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        x[i] = 0.01 * i - 1.5;
+        a[i] = std::cos(0.1 * i);
+        b[i] = 0.005 * i;
+        y[i] = 1.0 - 0.002 * i;
+    }
+    const scalar* inputValues[] = {&a.front(), &b.front()};
+    const scalar* outputValues[] = {&y.front()};
+    std::vector<scalar> result(rows);
+    function->evaluate(&x.front(), inputValues, outputValues, &result.front(), rows);
+
+    Context context(engine.get());
+    int mismatches = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        context.setInputValue(0, a[i]);
+        context.setInputValue(1, b[i]);
+        context.setOutputValue(0, y[i]);
+        if (result[i] != function->membership(x[i], context)) ++mismatches;
+    }
+    FL_CHECK(mismatches == 0);
+
+    //without columns, every row takes the values of the variables of the engine
+    engine->getInputVariable(0)->setInputValue(0.5);
+    engine->getInputVariable(1)->setInputValue(-0.25);
+    engine->getOutputVariable(0)->setOutputValue(0.75);
+    function->evaluate(&x.front(), fl::null, fl::null, &result.front(), rows);
+    mismatches = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (result[i] != function->membership(x[i])) ++mismatches;
+    }
+    FL_CHECK(mismatches == 0);
+}
+
+static void testDependsOnlyOnInputs() {
+    FL_unique_ptr<Engine> engine(createEngine());
+    FL_unique_ptr<Function> inputs(Function::create("f", "a * b + 1", engine.get()));
+    FL_CHECK(inputs->dependsOnlyOnInputs());
+    FL_unique_ptr<Function> x(Function::create("f", "a * x", engine.get()));
+    FL_CHECK(not x->dependsOnlyOnInputs());
+    FL_unique_ptr<Function> outputs(Function::create("f", "a + y", engine.get()));
+    FL_CHECK(not outputs->dependsOnlyOnInputs());
+}
+
+static std::size_t count(const Function& function, Function::Instruction::Opcode opcode) {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < function.instructions().size(); ++i) {
+        if (function.instructions().at(i).opcode == opcode) ++result;
+    }
+    return result;
+}
+
+static void testFoldingAndSharing() {
+    FL_unique_ptr<Engine> engine(createEngine());
+    //the constant subtree is folded into one constant
+    FL_unique_ptr<Function> folded(Function::create("f", "(1 + 2) * 4 / 2 + x", engine.get()));
+    FL_CHECK(folded->instructions().size() == 3);
+    FL_CHECK(count(*folded, Function::Instruction::Constant) == 1);
+    FL_CHECK(folded->membership(0.5) == 6.5);
+
+    //the repeated subtree is computed once, and loaded afterwards
+    FL_unique_ptr<Function> shared(Function::create("f",
+            "sin(a * b) * x + sin(a * b) / (1 + sin(a * b))", engine.get()));
+    FL_CHECK(count(*shared, Function::Instruction::LoadResult) == 2);
+    FL_CHECK(count(*shared, Function::Instruction::UnaryElement) == 1);
+    FL_CHECK(count(*shared, Function::Instruction::BinaryElement) == 5);
+}
+
+static void testCompiledAsInterpreted() {
+    FL_unique_ptr<Engine> engine(createEngine());
+    const char* formulas[] = {"x^2 - 3 * x + 2", "sin(x) * cos(x) + sin(x) * cos(x)",
+        "(1 + 2) * (x + a) / (b - 4 / 2)", "atan2(a, x) + pow(b, x) - atan2(a, x)",
+        "exp(~(x - a)^2 / (2 * b^2))", "~x * 2 / 3 + a * (2 / 3)", "y * (x + 1) - (x + 1) * y",
+        "2 * x + 1 / (3 - 3)"};
+    for (std::size_t f = 0; f < sizeof (formulas) / sizeof (formulas[0]); ++f) {
+        FL_unique_ptr<Function> function(Function::create("f", formulas[f], engine.get()));
+        FL_CHECK(function->isCompiled());
+        int mismatches = 0;
+        for (int i = 0; i < 100; ++i) {
+            scalar x = -2.0 + 0.04 * i, a = std::cos(0.3 * i), b = 0.5 + 0.01 * i, y = -a;
+            engine->getInputVariable(0)->setInputValue(a);
+            engine->getInputVariable(1)->setInputValue(b);
+            engine->getOutputVariable(0)->setOutputValue(y);
+            std::map<std::string, scalar> variables;
+            variables["x"] = x;
+            variables["a"] = a;
+            variables["b"] = b;
+            variables["y"] = y;
+            if (not test::isClose(function->membership(x), function->evaluate(&variables), 0.0)) {
+                ++mismatches;
+            }
+        }
+        if (not FL_CHECK(mismatches == 0)) std::cerr << formulas[f] << std::endl;
+    }
+}
+
+int main() {
+    try {
+        testBatchEvaluate();
+        testDependsOnlyOnInputs();
+        testFoldingAndSharing();
+        testCompiledAsInterpreted();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
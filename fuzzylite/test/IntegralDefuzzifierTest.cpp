@@ -0,0 +1,239 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <vector>
+
+using namespace fl;
+
+//Output values of the engine over a grid of input values
+static std::vector<scalar> evaluate(Engine* engine, int maximum) {
+    std::vector<scalar> result, inputValues;
+    DataReader data(engine, maximum);
+    engine->restart();
+    while (data.read(inputValues)) {
+        for (int i = 0; i < engine->numberOfInputVariables(); ++i) {
+            engine->getInputVariable(i)->setInputValue(inputValues.at(i));
+        }
+        engine->process();
+        for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+            OutputVariable* outputVariable = engine->getOutputVariable(i);
+            outputVariable->defuzzify();
+            result.push_back(outputVariable->getOutputValue());
+        }
+    }
+    return result;
+}
+
+static void testSupportsClippedByRange() {
+    //the support of the term goes past the maximum, and then past the minimum
+    Triangle right("right", 0.5, 1.0, 1.5);
+    Triangle left("left", -0.5, 0.0, 0.5);
+    for (int analytical = 0; analytical < 2; ++analytical) {
+        Centroid centroid(200);
+        centroid.setTolerance(1e-4);
+        centroid.setAnalytical(analytical);
+        Bisector bisector(200);
+        bisector.setTolerance(1e-4);
+        bisector.setAnalytical(analytical);
+        FL_CHECK(test::isClose(centroid.defuzzify(&right, 0.0, 1.0), 0.5 + 0.5 * 2.0 / 3.0, 1e-3));
+        FL_CHECK(test::isClose(bisector.defuzzify(&right, 0.0, 1.0), 0.5 + 0.5 * std::sqrt(0.5), 1e-3));
+        FL_CHECK(test::isClose(centroid.defuzzify(&left, 0.0, 1.0), 0.5 / 3.0, 1e-3));
+        FL_CHECK(test::isClose(bisector.defuzzify(&left, 0.0, 1.0), 0.5 * (1.0 - std::sqrt(0.5)), 1e-3));
+    }
+}
+
+static void testFlatRampSupport() {
+    Ramp flat("flat", 0.5, 0.5);
+    scalar low, high;
+    flat.support(low, high);
+    FL_CHECK(low > high);
+    //the flat ramp is skipped, leaving the support of the triangle
+    Accumulated accumulated("accumulated", 0.0, 1.0, new Maximum);
+    Triangle triangle("triangle", 0.0, 0.25, 0.5);
+    Minimum minimum;
+    accumulated.addTerm(&flat, 1.0, &minimum);
+    accumulated.addTerm(&triangle, 1.0, &minimum);
+    Centroid centroid(200);
+    centroid.setTolerance(1e-4);
+    FL_CHECK(test::isClose(centroid.defuzzify(&accumulated, 0.0, 1.0), 0.25, 1e-3));
+}
+
+static void testAnalyticalTerms() {
+    Trapezoid trapezoid("trapezoid", 0.0, 0.2, 0.6, 1.0);
+    Rectangle rectangle("rectangle", 0.2, 0.6);
+    Ramp ramp("ramp", 0.0, 1.0);
+    Centroid centroid(10);
+    centroid.setAnalytical(true);
+    Bisector bisector(10);
+    bisector.setAnalytical(true);
+    //exact values, regardless of the low resolution
+    FL_CHECK(test::isClose(centroid.defuzzify(&trapezoid, 0.0, 1.0), 0.32 / 0.7, 1e-12));
+    FL_CHECK(test::isClose(bisector.defuzzify(&trapezoid, 0.0, 1.0), 0.45, 1e-12));
+    FL_CHECK(test::isClose(centroid.defuzzify(&rectangle, 0.0, 1.0), 0.4, 1e-12));
+    FL_CHECK(test::isClose(bisector.defuzzify(&rectangle, 0.0, 1.0), 0.4, 1e-12));
+    FL_CHECK(test::isClose(centroid.defuzzify(&ramp, 0.0, 1.0), 2.0 / 3.0, 1e-12));
+    FL_CHECK(test::isClose(bisector.defuzzify(&ramp, 0.0, 1.0), std::sqrt(0.5), 1e-12));
+
+    //overlapping terms clipped by their degrees, as activated by the rules
+    Triangle low("low", 0.0, 0.25, 0.5);
+    Triangle high("high", 0.25, 0.75, 1.0);
+    Minimum minimum;
+    Accumulated accumulated("accumulated", 0.0, 1.0, new Maximum);
+    accumulated.addTerm(&low, 0.8, &minimum);
+    accumulated.addTerm(&high, 0.3, &minimum);
+    accumulated.addTerm(&trapezoid, 0.1, &minimum);
+    Centroid sampledCentroid(200000);
+    Bisector sampledBisector(200000);
+    FL_CHECK(test::isClose(centroid.defuzzify(&accumulated, 0.0, 1.0),
+            sampledCentroid.defuzzify(&accumulated, 0.0, 1.0), 1e-6));
+    FL_CHECK(test::isClose(bisector.defuzzify(&accumulated, 0.0, 1.0),
+            sampledBisector.defuzzify(&accumulated, 0.0, 1.0), 1e-5));
+}
+
+//Gaussian that counts the evaluations of its membership
+class CountedGaussian : public Gaussian {
+public:
+    mutable std::size_t evaluations;
+
+    CountedGaussian(const std::string& name, scalar mean, scalar standardDeviation)
+    : Gaussian(name, mean, standardDeviation), evaluations(0) {
+    }
+
+    virtual scalar membership(scalar x) const FL_IOVERRIDE {
+        ++evaluations;
+        return Gaussian::membership(x);
+    }
+
+    virtual void membership(const scalar* x, scalar* y, std::size_t n) const FL_IOVERRIDE {
+        evaluations += n;
+        Gaussian::membership(x, y, n);
+    }
+};
+
+static void testAdaptiveSampling() {
+    CountedGaussian narrow("narrow", 0.3, 0.02);
+    Bell wide("wide", 0.7, 0.1, 2.0);
+    AlgebraicProduct product;
+    Accumulated accumulated("accumulated", 0.0, 1.0, new Maximum);
+    accumulated.addTerm(&narrow, 0.7, &product);
+    accumulated.addTerm(&wide, 0.4, &product);
+    Centroid sampledCentroid(1000000);
+    Bisector sampledBisector(1000000);
+    const scalar expectedCentroid = sampledCentroid.defuzzify(&accumulated, 0.0, 1.0);
+    const scalar expectedBisector = sampledBisector.defuzzify(&accumulated, 0.0, 1.0);
+
+    Centroid centroid(100000);
+    centroid.setTolerance(1e-6);
+    Bisector bisector(100000);
+    bisector.setTolerance(1e-6);
+    narrow.evaluations = 0;
+    FL_CHECK(test::isClose(centroid.defuzzify(&accumulated, 0.0, 1.0), expectedCentroid, 1e-5));
+    //far fewer evaluations than the resolution, concentrated where the curve bends
+    FL_CHECK(narrow.evaluations > 0 and narrow.evaluations < 10000);
+    const std::size_t evaluations = narrow.evaluations;
+    FL_CHECK(test::isClose(bisector.defuzzify(&accumulated, 0.0, 1.0), expectedBisector, 1e-5));
+
+    //a coarser tolerance evaluates fewer points
+    narrow.evaluations = 0;
+    centroid.setTolerance(1e-3);
+    FL_CHECK(test::isClose(centroid.defuzzify(&accumulated, 0.0, 1.0), expectedCentroid, 1e-3));
+    FL_CHECK(2 * narrow.evaluations < evaluations);
+}
+
+static void testExamplesAnalytical(const std::string& path) {
+    //the last two are sampled, since they activate or accumulate with other norms
+    const char* examples[] = {"/mamdani/SimpleDimmer", "/mamdani/matlab/tipper",
+        "/mamdani/matlab/shower", "/mamdani/matlab/tank", "/mamdani/octave/mamdani_tip_calculator"};
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        for (int bisector = 0; bisector < 2; ++bisector) {
+            FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+            std::vector<scalar> ranges;
+            for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+                OutputVariable* outputVariable = engine->getOutputVariable(i);
+                ranges.push_back(outputVariable->range());
+                if (bisector) outputVariable->setDefuzzifier(new Bisector);
+                static_cast<IntegralDefuzzifier*> (outputVariable->getDefuzzifier())->setResolution(10000);
+            }
+            std::vector<scalar> expected = evaluate(engine.get(), 64);
+            for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+                static_cast<IntegralDefuzzifier*> (engine->getOutputVariable(i)->getDefuzzifier())
+                        ->setAnalytical(true);
+            }
+            std::vector<scalar> obtained = evaluate(engine.get(), 64);
+            FL_CHECK(obtained.size() == expected.size());
+            for (std::size_t i = 0; i < obtained.size() and i < expected.size(); ++i) {
+                scalar tolerance = 1e-3 * ranges.at(i % ranges.size());
+                if (not FL_CHECK(test::isClose(obtained.at(i), expected.at(i), tolerance))) {
+                    std::cerr << examples[e] << ": " << obtained.at(i) << " vs " << expected.at(i) << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void testExamplesWithTolerance(const std::string& path) {
+    const char* examples[] = {"/mamdani/SimpleDimmerChained", "/mamdani/AllTerms",
+        "/mamdani/matlab/mam21", "/mamdani/matlab/mam22",
+        "/mamdani/octave/investment_portfolio", "/mamdani/octave/mamdani_tip_calculator"};
+    for (std::size_t e = 0; e < sizeof (examples) / sizeof (examples[0]); ++e) {
+        FL_unique_ptr<Engine> engine(test::importEngine(path + examples[e] + ".fll"));
+        std::vector<scalar> expected = evaluate(engine.get(), 256);
+        std::vector<scalar> ranges;
+        for (int i = 0; i < engine->numberOfOutputVariables(); ++i) {
+            OutputVariable* outputVariable = engine->getOutputVariable(i);
+            ranges.push_back(outputVariable->range());
+            IntegralDefuzzifier* defuzzifier = dynamic_cast<IntegralDefuzzifier*> (
+                    outputVariable->getDefuzzifier());
+            if (defuzzifier) defuzzifier->setTolerance(1e-4);
+        }
+        std::vector<scalar> obtained = evaluate(engine.get(), 256);
+        FL_CHECK(obtained.size() == expected.size());
+        for (std::size_t i = 0; i < obtained.size() and i < expected.size(); ++i) {
+            //the resolution of the sampling bounds the difference
+            scalar tolerance = 0.01 * ranges.at(i % ranges.size());
+            if (not FL_CHECK(test::isClose(obtained.at(i), expected.at(i), tolerance))) {
+                std::cerr << examples[e] << ": " << obtained.at(i) << " vs " << expected.at(i) << std::endl;
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        testSupportsClippedByRange();
+        testFlatRampSupport();
+        testAnalyticalTerms();
+        testAdaptiveSampling();
+        testExamplesAnalytical(test::examples(argc, argv));
+        testExamplesWithTolerance(test::examples(argc, argv));
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
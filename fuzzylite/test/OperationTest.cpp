@@ -0,0 +1,143 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#include "test/Test.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <vector>
+
+using namespace fl;
+
+//The formatting through a stream that Op::str replaces
+static std::string streamed(scalar x, int decimals) {
+    std::ostringstream ss;
+    ss << std::setprecision(decimals) << std::fixed;
+    if (Op::isNaN(x)) {
+        ss << "nan";
+    } else if (Op::isInf(x)) {
+        ss << (Op::isLt(x, 0.0) ? "-inf" : "inf");
+    } else if (Op::isEq(x, 0.0)) {
+        ss << 0.0;
+    } else ss << x;
+    return ss.str();
+}
+
+static std::vector<scalar> values() {
+    std::vector<scalar> result;
+    const scalar special[] = {0.0, -0.0, 1e-12, -1e-12, 0.5, -0.5, 1.5, 2.5, 0.125, 0.0005,
+        -0.0004, 0.045, 1.005, 999.9995, 4503599627370495.5, 1e16, 1e300, -1e300,
+        fl::nan, fl::inf, -fl::inf};
+    result.insert(result.end(), special, special + sizeof (special) / sizeof (special[0]));
+    std::srand(7);
+    for (int i = 0; i < 20000; ++i) {
+        scalar mantissa = scalar(std::rand()) / RAND_MAX - 0.5;
+        result.push_back(mantissa * std::pow(10.0, std::rand() % 24 - 12));
+    }
+    //midpoints between the values of a few decimals, and their neighbours
+    for (int i = 0; i < 2000; ++i) {
+        int decimals = i % 9;
+        scalar midpoint = (std::rand() % 100000 + 0.5) / std::pow(10.0, decimals);
+        result.push_back(midpoint);
+        result.push_back(-midpoint);
+        result.push_back(midpoint * (1.0 + 2.220446049250313e-16));
+        result.push_back(midpoint * (1.0 - 2.220446049250313e-16));
+    }
+    return result;
+}
+
+static void testStr() {
+    std::vector<scalar> x = values();
+    const int decimals[] = {0, 1, 2, 3, 6, 8, 12, 15, 17, 20};
+    int mismatches = 0;
+    for (std::size_t d = 0; d < sizeof (decimals) / sizeof (decimals[0]); ++d) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (Op::str(x.at(i), decimals[d]) != streamed(x.at(i), decimals[d])) {
+                if (++mismatches <= 10) {
+                    std::cerr << std::setprecision(17) << x.at(i) << " with " << decimals[d]
+                            << " decimals: " << Op::str(x.at(i), decimals[d]) << " instead of "
+                            << streamed(x.at(i), decimals[d]) << std::endl;
+                }
+            }
+        }
+    }
+    FL_CHECK(mismatches == 0);
+
+    std::string text = "x=";
+    Op::str(scalar(-1.25), 1, text);
+    FL_CHECK(text == "x=" + streamed(-1.25, 1));
+}
+
+//The value of the text, or the message of its failure
+static std::string parsed(const std::string& text, bool inPlace) {
+    try {
+        scalar result = inPlace
+                ? Op::parseScalar(text.data(), text.data() + text.size())
+                : Op::toScalar(text);
+        std::ostringstream ss;
+        ss << std::setprecision(17) << result;
+        return ss.str();
+    } catch (fl::Exception& ex) {
+        return ex.getWhat().substr(0, ex.getWhat().find('\n'));
+    }
+}
+
+static void testParseScalar() {
+    std::vector<std::string> texts;
+    const char* special[] = {"0", "-0", "1", "+1", "-2.5e-3", "2.5E+3", ".5", "5.", "1e308",
+        "1e400", "-1e400", "1e-400", "nan", "inf", "-inf", "NaN", "1.5x", "", " ", " 1", "1 ",
+        "+", "-", ".", "e5", "1e", "1e+", "--1", "1-", "0x10", "1.2.3", "1,5", "\t2"};
+    texts.insert(texts.end(), special, special + sizeof (special) / sizeof (special[0]));
+    texts.push_back("0." + std::string(70, '0') + "1");
+    texts.push_back(std::string(70, '9'));
+    std::srand(11);
+    char buffer[64];
+    for (int i = 0; i < 5000; ++i) {
+        scalar x = (scalar(std::rand()) / RAND_MAX - 0.5) * std::pow(10.0, std::rand() % 40 - 20);
+        std::sprintf(buffer, i % 2 ? "%.17g" : "%.8f", double(x));
+        texts.push_back(buffer);
+    }
+    int mismatches = 0;
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+        if (parsed(texts.at(i), true) != parsed(texts.at(i), false)) {
+            if (++mismatches <= 10) {
+                std::cerr << "<" << texts.at(i) << ">: " << parsed(texts.at(i), true)
+                        << " instead of " << parsed(texts.at(i), false) << std::endl;
+            }
+        }
+    }
+    FL_CHECK(mismatches == 0);
+    FL_CHECK(Op::isNaN(Op::parseScalar(special[12], special[12] + 3)));
+}
+
+int main() {
+    try {
+        testStr();
+        testParseScalar();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return test::result();
+}
@@ -0,0 +1,87 @@
+/*
+ Author: Juan Rada-Vilela, Ph.D.
+ Copyright (C) 2010-2014 FuzzyLite Limited
+ All rights reserved
+
+ This file is part of fuzzylite.
+
+ fuzzylite is free software: you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation, either version 3 of the License, or (at your option)
+ any later version.
+
+ fuzzylite is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ for more details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with fuzzylite.  If not, see <http://www.gnu.org/licenses/>.
+
+ fuzzylite™ is a trademark of FuzzyLite Limited.
+
+ */
+
+#ifndef FL_TEST_H
+#define FL_TEST_H
+
+#include "fl/Headers.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace fl {
+    namespace test {
+
+        inline int& failures() {
+            static int result = 0;
+            return result;
+        }
+
+        inline bool check(bool condition, const char* expression, const char* file, int line) {
+            if (not condition) {
+                ++failures();
+                std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+            }
+            return condition;
+        }
+
+        //Whether the values are equal within the tolerance, or both nan
+        inline bool isClose(scalar a, scalar b, scalar tolerance) {
+            if (Op::isNaN(a) or Op::isNaN(b)) return Op::isNaN(a) and Op::isNaN(b);
+            return a == b or std::abs(a - b) <= tolerance;
+        }
+
+        inline std::string read(const std::string& path) {
+            std::ifstream reader(path.c_str(), std::ios::in | std::ios::binary);
+            if (not reader.is_open()) {
+                throw fl::Exception("[test error] file <" + path + "> could not be opened", FL_AT);
+            }
+            std::ostringstream result;
+            result << reader.rdbuf();
+            return result.str();
+        }
+
+        inline Engine* importEngine(const std::string& path) {
+            return FllImporter().fromString(read(path));
+        }
+
+        //The path to the examples given as the first argument
+        inline std::string examples(int argc, char** argv) {
+            return argc > 1 ? std::string(argv[1]) : std::string("../examples");
+        }
+
+        inline int result() {
+            if (failures() > 0) std::cerr << failures() << " checks failed" << std::endl;
+            return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+}
+
+#define FL_CHECK(condition) fl::test::check((condition), #condition, __FILE__, __LINE__)
+
+#endif  /* FL_TEST_H */